@@ -0,0 +1,92 @@
+#include "deque.hpp"
+
+#include <iostream>
+
+void TestBothEnds()
+{
+	std::cout << "Testing both ends..." << std::endl;
+	sjtu::deque<long long> q;
+	for (long long i = 0; i < 1LL << 20; ++i) {
+		q.push_back(i);
+	}
+	for (long long i = 0; i < 1LL << 11; ++i) {
+		q.push_front(-i);
+	}
+	std::cout << q.size() << " " << q.front() << " " << q.back() << std::endl;
+	for (long long i = 0; i < 1LL << 10; ++i) {
+		q.pop_front();
+	}
+	for (int i = 0; i < 5; ++i) {
+		std::cout << q.front() << std::endl;
+		q.pop_front();
+	}
+}
+
+void TestSlidingWindow()
+{
+	std::cout << "Testing sliding window..." << std::endl;
+	sjtu::deque<int> q;
+	long long sum = 0;
+	for (int i = 0; i < 100000; ++i) {
+		q.push_back(i);
+		sum += i;
+		if (q.size() > 100) {
+			sum -= q.front();
+			q.pop_front();
+		}
+	}
+	std::cout << q.size() << " " << sum << " " << q[0] << " " << q[99] << std::endl;
+}
+
+void TestInsertErase()
+{
+	std::cout << "Testing insert and erase..." << std::endl;
+	sjtu::deque<int> q;
+	for (int i = 0; i < 10; ++i) {
+		q.push_back(i);
+	}
+	q.insert(q.begin() + 2, 100);
+	q.insert(q.begin() + 8, 200);
+	q.erase(q.begin());
+	q.erase(q.end() - 1);
+	for (sjtu::deque<int>::iterator it = q.begin(); it != q.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	const sjtu::deque<int> qc(q);
+	for (sjtu::deque<int>::const_iterator it = qc.cbegin(); it != qc.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestException()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::deque<int> q, p;
+	try {
+		q.pop_front();
+	} catch(sjtu::container_is_empty &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	q.push_back(1);
+	try {
+		q.at(1);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		q.insert(p.begin(), 1);
+	} catch(sjtu::invalid_iterator &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestBothEnds();
+	TestSlidingWindow();
+	TestInsertErase();
+	TestException();
+	return 0;
+}
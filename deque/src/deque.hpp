@@ -0,0 +1,428 @@
+#ifndef SJTU_DEQUE_HPP
+#define SJTU_DEQUE_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a container like std::deque.
+ * the elements live in blocks of BLOCK elements, which never move. the
+ * blocks are listed in a circular map, so adding a block at either end is
+ * O(1) (amortized, when the map doubles). element i is at offset
+ * first + i of the concatenated blocks, which gives O(1) random access.
+ */
+template <typename T> class deque {
+private:
+  static const size_t BLOCK = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+
+  T **map;      // circular array of blocks
+  size_t mcap;  // capacity of map, a power of two
+  size_t head;  // index in map of the first block
+  size_t nblk;  // number of blocks in use
+  size_t first; // offset of the first element in the first block
+  size_t siz;   // size
+  T *spare;     // a freed block kept for reuse
+  std::allocator<T> alloc;
+  std::allocator<T *> map_alloc;
+
+  using traits = std::allocator_traits<std::allocator<T>>;
+
+  T *&block(size_t k) const { return map[(head + k) & (mcap - 1)]; }
+  T *slot(size_t pos) const {
+    size_t x = first + pos;
+    return block(x / BLOCK) + x % BLOCK;
+  }
+
+  T *new_block() {
+    if (spare != nullptr) {
+      T *p = spare;
+      spare = nullptr;
+      return p;
+    }
+    return alloc.allocate(BLOCK);
+  }
+  void free_block(T *p) {
+    if (spare == nullptr) {
+      spare = p;
+    } else {
+      alloc.deallocate(p, BLOCK);
+    }
+  }
+
+  /**
+   * @brief double the map when it is full, laying the blocks out from 0
+   */
+  void expand_map() {
+    if (nblk < mcap) {
+      return;
+    }
+    size_t newcap = mcap ? mcap * 2 : 8;
+    T **p = map_alloc.allocate(newcap);
+    for (size_t k = 0; k < nblk; k++) {
+      p[k] = block(k);
+    }
+    if (map != nullptr) {
+      map_alloc.deallocate(map, mcap);
+    }
+    map = p;
+    mcap = newcap;
+    head = 0;
+  }
+
+  void push_block_back() {
+    expand_map();
+    block(nblk) = new_block();
+    nblk++;
+  }
+  void push_block_front() {
+    expand_map();
+    // allocate first, a throw must leave the map as it was
+    T *p = new_block();
+    head = (head + mcap - 1) & (mcap - 1);
+    block(0) = p;
+    nblk++;
+    first += BLOCK;
+  }
+
+  /**
+   * @brief give back the blocks left empty at either end
+   */
+  void trim() {
+    while (nblk > 0 && first >= BLOCK) {
+      free_block(block(0));
+      head = (head + 1) & (mcap - 1);
+      nblk--;
+      first -= BLOCK;
+    }
+    while (nblk > 0 && first + siz <= (nblk - 1) * BLOCK) {
+      free_block(block(nblk - 1));
+      nblk--;
+    }
+    if (nblk == 0) {
+      first = 0;
+    }
+  }
+
+  template <bool Const> class basic_iterator {
+    friend class deque;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    using owner_type = std::conditional_t<Const, const deque *, deque *>;
+    owner_type owner;
+    size_t pos;
+
+    basic_iterator(owner_type o, size_t p) : owner(o), pos(p) {}
+
+  public:
+    basic_iterator() : owner(nullptr), pos(0) {}
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &it) : owner(it.owner), pos(it.pos) {}
+
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(owner, pos + n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(owner, pos - n);
+    }
+    // return the distance between two iterators,
+    // if these two iterators point to different deques, throw
+    // invaild_iterator.
+    difference_type operator-(const basic_iterator &rhs) const {
+      if (owner != rhs.owner) {
+        throw invalid_iterator();
+      }
+      return difference_type(pos - rhs.pos);
+    }
+    basic_iterator &operator+=(difference_type n) {
+      pos += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      pos -= n;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      pos++;
+      return tmp;
+    }
+    basic_iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      pos--;
+      return tmp;
+    }
+    basic_iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    /**
+     * throw invalid_iterator if it does not point to an element
+     */
+    reference operator*() const {
+      if (owner == nullptr || pos >= owner->siz) {
+        throw invalid_iterator();
+      }
+      return *owner->slot(pos);
+    }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    bool operator==(const basic_iterator &rhs) const {
+      return owner == rhs.owner && pos == rhs.pos;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return pos < rhs.pos; }
+    bool operator>(const basic_iterator &rhs) const { return pos > rhs.pos; }
+    bool operator<=(const basic_iterator &rhs) const { return pos <= rhs.pos; }
+    bool operator>=(const basic_iterator &rhs) const { return pos >= rhs.pos; }
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  /**
+   * Constructors
+   */
+  deque()
+      : map(nullptr), mcap(0), head(0), nblk(0), first(0), siz(0),
+        spare(nullptr) {}
+  deque(const deque &other) : deque() {
+    for (size_t i = 0; i < other.siz; i++) {
+      push_back(other[i]);
+    }
+  }
+  /**
+   * Destructor
+   */
+  ~deque() {
+    clear();
+    for (size_t k = 0; k < nblk; k++) {
+      alloc.deallocate(block(k), BLOCK);
+    }
+    if (spare != nullptr) {
+      alloc.deallocate(spare, BLOCK);
+    }
+    if (map != nullptr) {
+      map_alloc.deallocate(map, mcap);
+    }
+  }
+  /**
+   * Assignment operator
+   */
+  deque &operator=(const deque &other) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    for (size_t i = 0; i < other.siz; i++) {
+      push_back(other[i]);
+    }
+    return *this;
+  }
+  /**
+   * access specified element with bounds checking
+   * throw index_out_of_bound if out of bound.
+   */
+  T &at(const size_t &pos) {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return *slot(pos);
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return *slot(pos);
+  }
+  T &operator[](const size_t &pos) { return at(pos); }
+  const T &operator[](const size_t &pos) const { return at(pos); }
+  /**
+   * access the first element
+   * throw container_is_empty when the container is empty.
+   */
+  const T &front() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return *slot(0);
+  }
+  /**
+   * access the last element
+   * throw container_is_empty when the container is empty.
+   */
+  const T &back() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return *slot(siz - 1);
+  }
+  /**
+   * returns an iterator to the beginning.
+   */
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  /**
+   * returns an iterator to the end.
+   */
+  iterator end() { return iterator(this, siz); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(this, siz); }
+  /**
+   * checks whether the container is empty.
+   */
+  bool empty() const { return !siz; }
+  /**
+   * returns the number of elements
+   */
+  size_t size() const { return siz; }
+  /**
+   * clears the contents
+   */
+  void clear() {
+    while (siz > 0) {
+      pop_back();
+    }
+  }
+  /**
+   * inserts elements at the specified location in the container.
+   * inserts value before pos, moving the shorter side by one.
+   * returns an iterator pointing to the inserted value
+   * throw if the iterator is invalid or it points to a wrong place.
+   */
+  iterator insert(iterator pos, const T &value) {
+    if (pos.owner != this || pos.pos > siz) {
+      throw invalid_iterator();
+    }
+    size_t ind = pos.pos;
+    T tmp(value); // value may be an element about to move
+    if (ind < siz / 2) {
+      if (ind == 0) {
+        push_front(std::move(tmp));
+        return begin();
+      }
+      push_front(std::move(*slot(0)));
+      for (size_t i = 1; i < ind; i++) {
+        *slot(i) = std::move(*slot(i + 1));
+      }
+    } else {
+      if (ind == siz) {
+        push_back(std::move(tmp));
+        return begin() + ind;
+      }
+      push_back(std::move(*slot(siz - 1)));
+      for (size_t i = siz - 2; i > ind; i--) {
+        *slot(i) = std::move(*slot(i - 1));
+      }
+    }
+    *slot(ind) = std::move(tmp);
+    return begin() + ind;
+  }
+  /**
+   * removes specified element at pos, moving the shorter side by one.
+   * returns an iterator pointing to the following element, if pos pointing to
+   * the last element, end() will be returned.
+   * throw if the container is empty, the iterator is invalid or it points to
+   * a wrong place.
+   */
+  iterator erase(iterator pos) {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    if (pos.owner != this || pos.pos >= siz) {
+      throw invalid_iterator();
+    }
+    size_t ind = pos.pos;
+    if (ind < siz / 2) {
+      for (size_t i = ind; i > 0; i--) {
+        *slot(i) = std::move(*slot(i - 1));
+      }
+      pop_front();
+    } else {
+      for (size_t i = ind; i + 1 < siz; i++) {
+        *slot(i) = std::move(*slot(i + 1));
+      }
+      pop_back();
+    }
+    return begin() + ind;
+  }
+  /**
+   * adds an element to the end
+   */
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (first + siz == nblk * BLOCK) {
+      push_block_back();
+    }
+    T *p = slot(siz);
+    traits::construct(alloc, p, std::forward<Args>(args)...);
+    siz++;
+    return *p;
+  }
+  /**
+   * removes the last element
+   * throw when the container is empty.
+   */
+  void pop_back() {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    traits::destroy(alloc, slot(--siz));
+    trim();
+  }
+  /**
+   * inserts an element to the beginning.
+   */
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+  template <typename... Args> T &emplace_front(Args &&...args) {
+    if (first == 0) {
+      push_block_front();
+    }
+    T *p = block((first - 1) / BLOCK) + (first - 1) % BLOCK;
+    traits::construct(alloc, p, std::forward<Args>(args)...);
+    first--;
+    siz++;
+    return *p;
+  }
+  /**
+   * removes the first element.
+   * throw when the container is empty.
+   */
+  void pop_front() {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    traits::destroy(alloc, slot(0));
+    first++;
+    siz--;
+    trim();
+  }
+};
+
+} // namespace sjtu
+
+#endif
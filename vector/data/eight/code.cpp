@@ -0,0 +1,135 @@
+#include "src/concurrent_vector.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// an allocator that throws while failing is set
+bool failing = false;
+
+template <typename T> struct failing_allocator : std::allocator<T> {
+	template <typename U> struct rebind {
+		using other = failing_allocator<U>;
+	};
+	failing_allocator() = default;
+	template <typename U> failing_allocator(const failing_allocator<U> &) {}
+	T *allocate(size_t n)
+	{
+		if (failing) {
+			throw std::bad_alloc();
+		}
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+void TestConcurrentPush()
+{
+	std::cout << "Testing concurrent push_back..." << std::endl;
+	const int threads = 16, per = 20000;
+	sjtu::concurrent_vector<long long> v;
+	std::atomic<bool> done(false);
+	std::atomic<bool> bad(false);
+	std::thread reader([&]() {
+		while (!done.load()) {
+			size_t n = v.size();
+			for (size_t i = 0; i < n; ++i) {
+				long long x = v[i];
+				if (x < 0 || x >= (long long)threads * per) {
+					bad.store(true);
+				}
+			}
+		}
+	});
+	std::vector<std::thread> producers;
+	for (int t = 0; t < threads; ++t) {
+		producers.emplace_back([&v, t]() {
+			for (int i = 0; i < per; ++i) {
+				v.push_back((long long)t * per + i);
+			}
+		});
+	}
+	for (auto &th : producers) {
+		th.join();
+	}
+	done.store(true);
+	reader.join();
+	std::cout << v.size() << " " << (bad.load() ? "bad" : "good") << std::endl;
+	std::vector<char> seen(threads * per, 0);
+	long long sum = 0;
+	for (sjtu::concurrent_vector<long long>::iterator it = v.begin(); it != v.end(); ++it) {
+		seen[*it]++;
+		sum += *it;
+	}
+	bool once = true;
+	for (char c : seen) {
+		once = once && c == 1;
+	}
+	std::cout << sum << " " << (once ? "each once" : "mismatch") << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing non-trivial elements..." << std::endl;
+	sjtu::concurrent_vector<std::string> v;
+	std::vector<std::thread> producers;
+	for (int t = 0; t < 4; ++t) {
+		producers.emplace_back([&v, t]() {
+			for (int i = 0; i < 1000; ++i) {
+				v.emplace_back(40, char('a' + t));
+			}
+		});
+	}
+	for (auto &th : producers) {
+		th.join();
+	}
+	size_t count[4] = {0, 0, 0, 0};
+	for (size_t i = 0; i < v.size(); ++i) {
+		count[v[i][0] - 'a']++;
+	}
+	std::cout << v.size() << " " << count[0] << " " << count[3] << std::endl;
+	size_t cap = v.capacity();
+	v.clear();
+	std::cout << v.size() << " " << (v.capacity() == cap) << std::endl;
+	size_t pos = v.push_back(std::string("again"));
+	std::cout << pos << " " << v.at(0) << std::endl;
+	try {
+		v.at(1);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestFailedAllocation()
+{
+	std::cout << "Testing failed block allocation..." << std::endl;
+	// the first block holds 16 elements
+	sjtu::concurrent_vector<std::string, failing_allocator<std::string>> v;
+	for (int i = 0; i < 16; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	failing = true;
+	try {
+		v.push_back("lost");
+	} catch (const std::bad_alloc &) {
+		std::cout << "bad_alloc" << std::endl;
+	}
+	failing = false;
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	size_t pos = v.push_back("next");
+	std::cout << pos << " " << v.size() << " " << v[16] << std::endl;
+	v.clear();
+	v.push_back("after clear");
+	std::cout << v.size() << " " << v[0] << std::endl;
+}
+
+int main()
+{
+	TestConcurrentPush();
+	TestStrings();
+	TestFailedAllocation();
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include "src/vector.hpp"
+
+#include <iostream>
+#include <string>
+
+void print(const sjtu::vector<int> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestCapacity()
+{
+	std::cout << "Testing capacity functions..." << std::endl;
+	sjtu::vector<int> v;
+	v.reserve(100);
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.capacity() << std::endl;
+	v.reserve(10);
+	std::cout << v.capacity() << std::endl;
+	v.resize(5);
+	print(v);
+	v.resize(8, -1);
+	print(v);
+	v.resize(10);
+	print(v);
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.resize(0);
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+void TestResizeStrings()
+{
+	std::cout << "Testing resize of strings..." << std::endl;
+	sjtu::vector<std::string> v;
+	v.resize(3);
+	v.resize(6, "ab");
+	v[0] = "x";
+	// value refers into the vector, which reallocates
+	v.resize(50, v[0]);
+	std::cout << v.size() << " " << v[0] << v[4] << v[49] << std::endl;
+	v.resize(2);
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << " " << v[1].empty()
+	          << std::endl;
+}
+
+int main()
+{
+	TestCapacity();
+	TestResizeStrings();
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include "src/soa_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestGuests()
+{
+	std::cout << "Testing guest columns..." << std::endl;
+	// guest{x, y} as two parallel arrays
+	sjtu::soa_vector<int, int> guests;
+	for (int i = 0; i < 100000; ++i) {
+		guests.push_back(i / 10, i % 10);
+	}
+	const int *xs = guests.column<0>();
+	long long sumx = 0;
+	for (size_t i = 0; i < guests.size(); ++i) {
+		sumx += xs[i];
+	}
+	long long value = 0;
+	for (auto [x, y] : guests) {
+		value += x * 10 + y;
+	}
+	std::cout << guests.size() << " " << sumx << " " << value << std::endl;
+	for (auto [x, y] : guests) {
+		std::swap(x, y);
+	}
+	std::cout << guests.get<0>(12345) << " " << guests.get<1>(12345) << std::endl;
+}
+
+void TestRows()
+{
+	std::cout << "Testing rows..." << std::endl;
+	sjtu::soa_vector<std::string, double, int> v;
+	v.push_back(std::string("apple"), 1.5, 3);
+	v.push_back(std::string("banana"), 0.25, 12);
+	std::string name = "cherry";
+	v.push_back(name, 4.0, 7);
+	v.push_back(v[0]);
+	std::get<2>(v[3]) = 100;
+	v.erase(1);
+	for (sjtu::soa_vector<std::string, double, int>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << std::get<0>(*it) << " " << std::get<1>(*it) << " " << std::get<2>(*it) << std::endl;
+	}
+	v.pop_back();
+	v.resize(4);
+	std::cout << v.size() << " [" << v.get<0>(3) << "] " << v.get<2>(3) << std::endl;
+	const sjtu::soa_vector<std::string, double, int> copy(v);
+	std::cout << std::get<0>(copy.at(1)) << std::endl;
+	try {
+		copy.at(4);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	v.clear();
+	try {
+		v.pop_back();
+	} catch(sjtu::container_is_empty &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestFlags()
+{
+	std::cout << "Testing bool columns..." << std::endl;
+	// a bool field lives in a column of unsigned char
+	sjtu::soa_vector<int, bool> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i, i % 3 == 0);
+	}
+	const unsigned char *alive = v.column<1>();
+	int count = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		count += alive[i];
+	}
+	for (auto [id, flag] : v) {
+		flag = id % 2 == 0;
+	}
+	int even = 0;
+	for (auto [id, flag] : v) {
+		even += flag ? 1 : 0;
+	}
+	std::tuple<int, bool> row = v[8];
+	v.push_back(row);
+	v.resize(v.size() + 2);
+	std::cout << count << " " << even << " " << std::get<0>(row) << " "
+		<< std::get<1>(row) << " " << int(v.get<1>(1002)) << " "
+		<< bool(v.get<1>(1000)) << std::endl;
+}
+
+int main()
+{
+	TestGuests();
+	TestRows();
+	TestFlags();
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include "src/vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// copies succeed until the countdown reaches zero, then throw
+int countdown = -1;
+int alive = 0;
+
+class Fragile {
+private:
+	std::string data;
+public:
+	Fragile(int value) : data(std::to_string(value)) { ++alive; }
+	Fragile(const Fragile &other) : data(other.data)
+	{
+		if (countdown >= 0 && countdown-- == 0) {
+			throw std::string("copy failed");
+		}
+		++alive;
+	}
+	// not noexcept, so a reallocation has to copy
+	Fragile(Fragile &&other) : Fragile(static_cast<const Fragile &>(other)) {}
+	Fragile &operator=(const Fragile &other)
+	{
+		data = other.data;
+		return *this;
+	}
+	~Fragile() { --alive; }
+	const std::string &str() const { return data; }
+};
+
+void print(const sjtu::vector<Fragile> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].str() << " ";
+	}
+	std::cout << "| size " << v.size() << ", alive " << alive << std::endl;
+}
+
+template <typename F> void attempt(const char *name, sjtu::vector<Fragile> &v, F f)
+{
+	countdown = 3;
+	try {
+		f();
+		std::cout << name << ": no exception" << std::endl;
+	} catch (const std::string &e) {
+		std::cout << name << ": " << e << std::endl;
+	}
+	countdown = -1;
+	print(v);
+}
+
+int main()
+{
+	sjtu::vector<Fragile> v;
+	v.reserve(6);
+	for (int i = 0; i < 6; ++i) {
+		v.push_back(Fragile(i));
+	}
+	print(v);
+	Fragile extra(42);
+	attempt("push_back", v, [&] { v.push_back(extra); });
+	attempt("emplace", v, [&] { v.emplace(2, 7); });
+	attempt("reserve", v, [&] { v.reserve(100); });
+	attempt("resize", v, [&] { v.resize(10, extra); });
+	attempt("copy", v, [&] { sjtu::vector<Fragile> w(v); });
+	sjtu::vector<Fragile> w;
+	for (int i = 10; i < 15; ++i) {
+		w.push_back(Fragile(i));
+	}
+	v.reserve(20);
+	attempt("insert n", v, [&] { v.insert(v.begin() + 1, 5, extra); });
+	attempt("insert range", v, [&] { v.insert(3, w.begin(), w.end()); });
+	attempt("push_back again", v, [&] { v.push_back(extra); });
+	return 0;
+}
@@ -0,0 +1,36 @@
+#include "vector.hpp"
+#include "allocator.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestAllocator()
+{
+	std::cout << "Testing allocators..." << std::endl;
+	sjtu::arena arena;
+	for (int round = 0; round < 3; ++round) {
+		sjtu::vector<long long, sjtu::arena_allocator<long long>> v{sjtu::arena_allocator<long long>(arena)};
+		for (long long i = 0; i < 1000; ++i) {
+			v.push_back(i * i);
+		}
+		sjtu::vector<long long, sjtu::arena_allocator<long long>> vv(v);
+		std::cout << vv.size() << " " << vv.back() << std::endl;
+		arena.reset();
+	}
+	sjtu::pool pool;
+	sjtu::vector<std::string, sjtu::pool_allocator<std::string>> vs{sjtu::pool_allocator<std::string>(pool)};
+	for (int i = 0; i < 100; ++i) {
+		vs.push_back(std::to_string(i));
+	}
+	vs.erase(vs.begin(), vs.begin() + 90);
+	for (size_t i = 0; i < vs.size(); ++i) {
+		std::cout << vs[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestAllocator();
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include "src/vector.hpp"
+#include "src/soa_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestSwapRemove()
+{
+	std::cout << "Testing swap_remove..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	v.swap_remove(2);
+	v.swap_remove(v.begin());
+	v.swap_remove(v.size() - 1);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	try {
+		v.swap_remove(v.size());
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 5; ++i) {
+		s.push_back(std::string(30, 'a' + i));
+	}
+	s.swap_remove(1);
+	s.swap_remove(3);
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i].substr(0, 3) << " ";
+	}
+	std::cout << s.size() << std::endl;
+}
+
+void TestEntities()
+{
+	std::cout << "Testing entity table..." << std::endl;
+	// an entity table that drops entities from random positions
+	sjtu::vector<long long> live;
+	for (long long i = 0; i < 200000; ++i) {
+		live.push_back(i);
+	}
+	unsigned seed = 12345;
+	for (int i = 0; i < 150000; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		live.swap_remove((seed >> 8) % live.size());
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < live.size(); ++i) {
+		sum += live[i];
+	}
+	std::cout << live.size() << " " << sum << std::endl;
+	sjtu::soa_vector<int, std::string> table;
+	for (int i = 0; i < 6; ++i) {
+		table.push_back(i, std::to_string(i * i));
+	}
+	table.swap_remove(0);
+	table.swap_remove(4);
+	for (auto [id, name] : table) {
+		std::cout << id << ":" << name << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestEraseIf()
+{
+	std::cout << "Testing erase_if..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_back(i);
+	}
+	size_t removed = v.erase_if([](int x) { return x % 3 != 0; });
+	std::cout << removed << " " << v.size() << " " << v[0] << " " << v[1]
+	          << " " << v.back() << std::endl;
+	std::cout << v.erase_if([](int) { return false; }) << " " << v.size()
+	          << std::endl;
+	std::cout << v.erase_if([](int) { return true; }) << " " << v.empty()
+	          << std::endl;
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 10; ++i) {
+		s.push_back(std::to_string(i) + std::string(20, '-'));
+	}
+	s.erase_if([](const std::string &x) { return (x[0] - '0') % 2 == 0; });
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i][0];
+	}
+	std::cout << " " << s.size() << std::endl;
+}
+
+int main()
+{
+	TestSwapRemove();
+	TestEntities();
+	TestEraseIf();
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include "src/simd.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+template <typename T>
+void TestColumn(const char *name)
+{
+	std::cout << "Testing " << name << " column..." << std::endl;
+	sjtu::vector<T> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(T((i * 7919) % 1000 - 300));
+	}
+	v[70001] = T(-1000);
+	v[123] = T(2000);
+	v[99999] = T(2000);
+	std::cout << sjtu::find(v, T(-1000)) << " " << sjtu::find(v, T(12345)) << std::endl;
+	std::cout << sjtu::count(v, T(0)) << " " << sjtu::count(v, T(2000)) << std::endl;
+	std::cout << sjtu::sum(v) << std::endl;
+	sjtu::extremum<T> mn = sjtu::min_element(v), mx = sjtu::max_element(v);
+	std::cout << mn.value << " " << mn.index << " " << mx.value << " " << mx.index << std::endl;
+	sjtu::fill(v, T(3));
+	std::cout << sjtu::count(v, T(3)) << " " << sjtu::sum(v) << std::endl;
+}
+
+void TestEdges()
+{
+	std::cout << "Testing edge cases..." << std::endl;
+	sjtu::vector<int> v;
+	std::cout << sjtu::find(v, 1) << " " << sjtu::count(v, 1) << " " << sjtu::sum(v) << std::endl;
+	try {
+		sjtu::min_element(v);
+	} catch(sjtu::container_is_empty &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i % 2);
+	}
+	sjtu::extremum<int> mn = sjtu::min_element(v), mx = sjtu::max_element(v);
+	std::cout << mn.index << " " << mx.index << " " << sjtu::count(v, 1) << std::endl;
+	sjtu::vector<int> big;
+	big.resize(3000000, 2000000000);
+	std::cout << sjtu::sum(big) << std::endl;
+}
+
+// the extremum of a column holding NaN may be any element, but must be one
+template <typename T>
+void TestNaN(const char *name)
+{
+	std::cout << "Testing " << name << " column with NaN..." << std::endl;
+	const T nan = std::numeric_limits<T>::quiet_NaN();
+	const int sizes[] = {1, 7, 1024, 1500, 5000};
+	for (int n : sizes) {
+		for (int at : {0, n / 2, n - 1}) {
+			sjtu::vector<T> v;
+			for (int i = 0; i < n; ++i) {
+				v.push_back(T(i % 100));
+			}
+			v[at] = nan;
+			sjtu::extremum<T> mn = sjtu::min_element(v), mx = sjtu::max_element(v);
+			bool ok = mn.index < v.size() && mx.index < v.size();
+			ok = ok && (mn.value == v[mn.index] || std::isnan(mn.value));
+			ok = ok && (mx.value == v[mx.index] || std::isnan(mx.value));
+			std::cout << ok;
+		}
+		std::cout << std::endl;
+	}
+}
+
+int main()
+{
+	TestColumn<int>("int");
+	TestColumn<long long>("long long");
+	TestColumn<float>("float");
+	TestColumn<double>("double");
+	TestNaN<float>("float");
+	TestNaN<double>("double");
+	TestEdges();
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include "src/vector.hpp"
+
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+// an allocator that refuses buffers of more than limit elements
+size_t limit = size_t(-1);
+
+template <typename T> struct limited_allocator : std::allocator<T> {
+	template <typename U> struct rebind {
+		using other = limited_allocator<U>;
+	};
+	limited_allocator() = default;
+	template <typename U> limited_allocator(const limited_allocator<U> &) {}
+	T *allocate(size_t n)
+	{
+		if (n > limit) {
+			throw std::bad_alloc();
+		}
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+void TestClear()
+{
+	std::cout << "Testing clear and release..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	size_t cap = v.capacity();
+	v.clear();
+	std::cout << v.size() << " " << (v.capacity() == cap) << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(std::to_string(-i));
+	}
+	std::cout << v.size() << " " << (v.capacity() == cap) << " " << v.back()
+	          << std::endl;
+	v.release();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+void TestAssign()
+{
+	std::cout << "Testing assignment..." << std::endl;
+	sjtu::vector<std::string> v, small, large;
+	for (int i = 0; i < 50; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	for (int i = 0; i < 10; ++i) {
+		small.push_back("s" + std::to_string(i));
+	}
+	for (int i = 0; i < 80; ++i) {
+		large.push_back("l" + std::to_string(i));
+	}
+	size_t cap = v.capacity();
+	v = small;
+	std::cout << v.size() << " " << (v.capacity() == cap) << " " << v.back()
+	          << std::endl;
+	v = large;
+	std::cout << v.size() << " " << v.capacity() << " " << v.back()
+	          << std::endl;
+	v = v;
+	std::cout << v.size() << " " << v[40] << std::endl;
+}
+
+void TestAssignFailure()
+{
+	std::cout << "Testing failed assignment..." << std::endl;
+	sjtu::vector<int, limited_allocator<int>> v, w;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	for (int i = 0; i < 1000; ++i) {
+		w.push_back(i);
+	}
+	limit = 100;
+	try {
+		v = w;
+	} catch (const std::bad_alloc &) {
+		std::cout << "bad_alloc" << std::endl;
+	}
+	limit = size_t(-1);
+	v.push_back(10);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	v = w;
+	std::cout << v.size() << " " << v.back() << std::endl;
+}
+
+int main()
+{
+	TestClear();
+	TestAssign();
+	TestAssignFailure();
+	return 0;
+}
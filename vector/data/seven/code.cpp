@@ -0,0 +1,115 @@
+#include "src/stable_vector.hpp"
+
+#include "data/class-integer.hpp"
+#include "data/class-matrix.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+void TestStable()
+{
+	std::cout << "Testing pointer stability..." << std::endl;
+	sjtu::stable_vector<long long> v;
+	v.push_back(0);
+	long long *first = &v[0];
+	for (long long i = 1; i < 1LL << 16; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.size() << " " << (first == &v[0]) << " " << *first << std::endl;
+	for (long long i = 0; i < 1LL << 16; i += 1LL << 12) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestIterators()
+{
+	std::cout << "Testing iterators..." << std::endl;
+	sjtu::stable_vector<int> v;
+	for (int i = 0; i < 40; ++i) {
+		v.push_back((i * 17) % 40);
+	}
+	std::sort(v.begin(), v.end());
+	for (sjtu::stable_vector<int>::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	const sjtu::stable_vector<int> vc(v);
+	std::cout << vc.cend() - vc.cbegin() << " " << *std::lower_bound(vc.cbegin(), vc.cend(), 25) << std::endl;
+}
+
+void TestClasses()
+{
+	std::cout << "Testing classes..." << std::endl;
+	sjtu::stable_vector<Integer> vInt;
+	for (int i = 1; i <= 100; ++i) {
+		vInt.push_back(Integer(i));
+	}
+	sjtu::stable_vector<Diamond::Matrix<double>> vM;
+	for (int i = 1; i <= 3; ++i) {
+		vM.push_back(Diamond::Matrix<double>(i, i, i));
+	}
+	sjtu::stable_vector<Diamond::Matrix<double>> vvM;
+	vvM = vM;
+	vM.pop_back();
+	for (size_t i = 0; i < vvM.size(); ++i) {
+		std::cout << vvM[i] << std::endl;
+	}
+	try {
+		vM.at(2);
+	} catch(...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+// copies succeed until the countdown reaches zero, then throw
+int countdown = -1;
+int alive = 0;
+
+class Fragile {
+private:
+	std::string data;
+public:
+	Fragile(int value) : data(std::to_string(value)) { ++alive; }
+	Fragile(const Fragile &other) : data(other.data)
+	{
+		if (countdown >= 0 && countdown-- == 0) {
+			throw std::string("copy failed");
+		}
+		++alive;
+	}
+	Fragile &operator=(const Fragile &other)
+	{
+		data = other.data;
+		return *this;
+	}
+	~Fragile() { --alive; }
+	const std::string &str() const { return data; }
+};
+
+void TestThrowingCopy()
+{
+	std::cout << "Testing throwing copies..." << std::endl;
+	sjtu::stable_vector<Fragile> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(Fragile(i));
+	}
+	countdown = 50;
+	try {
+		sjtu::stable_vector<Fragile> w(v);
+	} catch (const std::string &e) {
+		std::cout << e << std::endl;
+	}
+	countdown = -1;
+	std::cout << alive << " " << v.size() << " " << v[99].str() << std::endl;
+}
+
+int main()
+{
+	TestStable();
+	TestIterators();
+	TestClasses();
+	TestThrowingCopy();
+	return 0;
+}
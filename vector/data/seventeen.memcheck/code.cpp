@@ -0,0 +1,55 @@
+#include "vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+void TestEmplace()
+{
+	std::cout << "Testing emplace functions..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 5; ++i) {
+		v.emplace_back(i + 1, 'a' + i);
+	}
+	v.emplace(v.begin() + 2, 3, 'z');
+	v.emplace(0, v[5]);
+	v.push_back(v[0]);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<Util::Bint> vBint;
+	for (int i = 1; i <= 10; ++i) {
+		vBint.push_back(Util::Bint(i) * i);
+	}
+	std::cout << vBint.back() << std::endl;
+}
+
+void TestMoveOnly()
+{
+	std::cout << "Testing move-only elements..." << std::endl;
+	sjtu::vector<std::unique_ptr<int>> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(std::make_unique<int>(i));
+	}
+	v.insert(v.begin(), std::make_unique<int>(-1));
+	v.insert(10, std::make_unique<int>(100));
+	v.emplace(v.begin() + 5, new int(50));
+	int &last = *v.emplace_back(new int(99));
+	last++;
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << *v[i] << " ";
+	}
+	std::cout << std::endl;
+	v.erase(0);
+	std::cout << v.size() << " " << *v.front() << " " << *v.back() << std::endl;
+}
+
+int main()
+{
+	TestEmplace();
+	TestMoveOnly();
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include "small_vector.hpp"
+
+#include "class-integer.hpp"
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestInline()
+{
+	std::cout << "Testing inline storage..." << std::endl;
+	sjtu::small_vector<std::string, 4> v;
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	std::cout << v.size() << " " << v.is_inline() << std::endl;
+	v.push_back("spill");
+	std::cout << v.size() << " " << v.is_inline() << std::endl;
+	v.pop_back();
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.is_inline() << std::endl;
+	for (sjtu::small_vector<std::string, 4>::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestCopy()
+{
+	std::cout << "Testing copy..." << std::endl;
+	sjtu::small_vector<Util::Bint, 2> v;
+	for (int i = 1; i <= 5; ++i) {
+		v.push_back(Util::Bint(i) * i);
+	}
+	const sjtu::small_vector<Util::Bint, 2> vc(v);
+	sjtu::small_vector<Util::Bint, 2> vv;
+	vv.push_back(Util::Bint(-1));
+	vv = vc;
+	v.clear();
+	for (size_t i = 0; i < vv.size(); ++i) {
+		std::cout << vc[i] << " " << vv[i] << std::endl;
+	}
+	sjtu::small_vector<Integer, 8> vInt;
+	for (int i = 1; i <= 100; ++i) {
+		vInt.push_back(Integer(i));
+	}
+	std::cout << vInt.size() << std::endl;
+}
+
+void TestException()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::small_vector<int, 4> v;
+	try {
+		v.front();
+	} catch(sjtu::container_is_empty &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	v.push_back(1);
+	try {
+		v.at(4);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestInline();
+	TestCopy();
+	TestException();
+	return 0;
+}
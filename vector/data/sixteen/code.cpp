@@ -0,0 +1,82 @@
+#include "src/vector_malloc.hpp"
+
+#include <iostream>
+#include <new>
+#include <string>
+
+// grows as usual, but asks for far more than the address space past 1000
+struct greedy_growth {
+	static size_t next_capacity(size_t siz, size_t need, size_t elem_size)
+	{
+		if (siz >= 1000) {
+			return size_t(1) << 50;
+		}
+		return sjtu::geometric_growth<>::next_capacity(siz, need, elem_size);
+	}
+	void record_reallocation(size_t, size_t) {}
+};
+
+void TestMapped()
+{
+	std::cout << "Testing growth past the mmap threshold..." << std::endl;
+	// 8MB of ints, the buffer moves from malloc to mmap and is then remapped
+	sjtu::vector<int, sjtu::tracked_growth<>> v;
+	for (int i = 0; i < 2000000; ++i) {
+		v.push_back(i ^ 0x5555);
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << sum << " " << v[1234567] << std::endl;
+	std::cout << v.growth().reallocations << " " << v.growth().peak_capacity
+	          << std::endl;
+	sjtu::vector<int, sjtu::tracked_growth<>> w(v);
+	w.erase(0);
+	w.push_back(-1);
+	std::cout << w.size() << " " << w.front() << " " << w.back() << std::endl;
+	v = w;
+	std::cout << v.size() << " " << v[1999998] << std::endl;
+	v.clear();
+	for (int i = 0; i < 300000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.size() << " " << v.back() << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing large buffers of strings..." << std::endl;
+	// strings are not trivially relocatable, so they are never mapped
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	std::cout << v.size() << " " << v[99999] << std::endl;
+}
+
+void TestOutOfMemory()
+{
+	std::cout << "Testing failed growth..." << std::endl;
+	sjtu::vector<int, greedy_growth> v;
+	try {
+		for (int i = 0; i < 2000; ++i) {
+			v.push_back(i);
+		}
+	} catch (const std::bad_alloc &) {
+		std::cout << "bad_alloc" << std::endl;
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << sum << std::endl;
+}
+
+int main()
+{
+	TestMapped();
+	TestStrings();
+	TestOutOfMemory();
+	return 0;
+}
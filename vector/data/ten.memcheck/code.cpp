@@ -0,0 +1,136 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <new>
+
+// an allocator that refuses buffers of more than limit words
+size_t limit = size_t(-1);
+
+template <typename T> struct limited_allocator : std::allocator<T> {
+	template <typename U> struct rebind {
+		using other = limited_allocator<U>;
+	};
+	limited_allocator() = default;
+	template <typename U> limited_allocator(const limited_allocator<U> &) {}
+	T *allocate(size_t n)
+	{
+		if (n > limit) {
+			throw std::bad_alloc();
+		}
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+void TestSieve()
+{
+	std::cout << "Testing sieve..." << std::endl;
+	const size_t n = 10000000;
+	sjtu::vector<bool> composite;
+	composite.resize(n + 1);
+	composite[0] = composite[1] = true;
+	for (size_t i = 2; i * i <= n; ++i) {
+		if (!composite[i]) {
+			for (size_t j = i * i; j <= n; j += i) {
+				composite[j] = true;
+			}
+		}
+	}
+	composite.flip();
+	std::cout << composite.count() << " " << composite.capacity() / 8 << std::endl;
+	size_t p = composite.find_first();
+	for (int i = 0; i < 10; ++i) {
+		std::cout << p << " ";
+		p = composite.find_next(p);
+	}
+	std::cout << std::endl;
+}
+
+void TestEditing()
+{
+	std::cout << "Testing insert and erase..." << std::endl;
+	sjtu::vector<bool> v;
+	for (int i = 0; i < 130; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	v.insert(0, false);
+	v.insert(64, true);
+	v.erase(v.begin() + 100);
+	v.pop_back();
+	std::cout << v.size() << " " << v.count() << " " << v.front() << " " << v.back() << std::endl;
+	for (sjtu::vector<bool>::const_iterator it = v.cbegin(); it != v.cbegin() + 70; ++it) {
+		std::cout << *it;
+	}
+	std::cout << std::endl;
+	v.resize(200, true);
+	std::cout << v.count() << " " << v.find_next(128) << std::endl;
+}
+
+void TestBitwise()
+{
+	std::cout << "Testing bitwise operators..." << std::endl;
+	sjtu::vector<bool> a, b;
+	for (int i = 0; i < 1000; ++i) {
+		a.push_back(i % 2 == 0);
+		b.push_back(i % 3 == 0);
+	}
+	sjtu::vector<bool> c(a);
+	c &= b;
+	std::cout << c.count() << " ";
+	c = a;
+	c |= b;
+	std::cout << c.count() << " ";
+	c = a;
+	c ^= b;
+	std::cout << c.count() << std::endl;
+	b.pop_back();
+	try {
+		a &= b;
+	} catch(sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		a.at(1000);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestAssignFailure()
+{
+	std::cout << "Testing failed assignment..." << std::endl;
+	sjtu::vector<bool, limited_allocator<bool>> v, w;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	for (int i = 0; i < 10000; ++i) {
+		w.push_back(i % 2 == 0);
+	}
+	limit = 10;
+	try {
+		v = w;
+	} catch (const std::bad_alloc &) {
+		std::cout << "bad_alloc" << std::endl;
+	}
+	try {
+		sjtu::vector<bool, limited_allocator<bool>> u(w);
+	} catch (const std::bad_alloc &) {
+		std::cout << "bad_alloc" << std::endl;
+	}
+	limit = size_t(-1);
+	v.push_back(true);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i];
+	}
+	std::cout << std::endl;
+	v = w;
+	std::cout << v.size() << " " << v.count() << std::endl;
+}
+
+int main()
+{
+	TestSieve();
+	TestEditing();
+	TestBitwise();
+	TestAssignFailure();
+	return 0;
+}
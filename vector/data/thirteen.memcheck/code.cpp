@@ -0,0 +1,70 @@
+#include "persistent_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+void TestVersions()
+{
+	std::cout << "Testing versions..." << std::endl;
+	std::vector<sjtu::persistent_vector<int>> history;
+	sjtu::persistent_vector<int> v;
+	history.push_back(v);
+	for (int i = 0; i < 100000; ++i) {
+		v = v.push_back(i);
+		if (i % 10000 == 9999) {
+			history.push_back(v);
+		}
+	}
+	for (int i = 0; i < 1000; ++i) {
+		v = v.set(i * 97, -i);
+		history.push_back(v);
+	}
+	std::cout << history.size() << " " << v.size() << " " << v.depth() << std::endl;
+	std::cout << history[3].size() << " " << history[3].back() << std::endl;
+	std::cout << history[10].at(97) << " " << history[11].at(97) << " " << history[12].at(97) << std::endl;
+	std::cout << history[500].at(489 * 97) << " " << history[500].at(490 * 97) << std::endl;
+	long long sum = 0;
+	for (sjtu::persistent_vector<int>::const_iterator it = history[5].cbegin(); it != history[5].cend(); ++it) {
+		sum += *it;
+	}
+	std::cout << sum << std::endl;
+}
+
+void TestConcat()
+{
+	std::cout << "Testing concat..." << std::endl;
+	sjtu::persistent_vector<std::string> a, b;
+	for (int i = 0; i < 1000; ++i) {
+		a = a.push_back("a" + std::to_string(i));
+	}
+	for (int i = 0; i < 77; ++i) {
+		b = b.push_back("b" + std::to_string(i));
+	}
+	sjtu::persistent_vector<std::string> c = a + b + a;
+	std::cout << c.size() << " " << c[999] << " " << c[1000] << " " << c[1076] << " " << c[1077] << " " << c.back() << std::endl;
+	sjtu::persistent_vector<std::string> pieces;
+	for (int i = 0; i < 3000; ++i) {
+		pieces = pieces + sjtu::persistent_vector<std::string>().push_back(std::to_string(i));
+	}
+	std::cout << pieces.size() << " " << pieces[1234] << " " << pieces.depth() << std::endl;
+	sjtu::persistent_vector<std::string> d = c.set(1000, "changed");
+	std::cout << c[1000] << " " << d[1000] << " " << a.size() << std::endl;
+	try {
+		c.at(c.size());
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		sjtu::persistent_vector<int>().front();
+	} catch(sjtu::container_is_empty &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestVersions();
+	TestConcat();
+	return 0;
+}
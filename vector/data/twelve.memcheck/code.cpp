@@ -0,0 +1,117 @@
+#include "cow_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+void TestSharing()
+{
+	std::cout << "Testing sharing..." << std::endl;
+	sjtu::cow_vector<int> v;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_back(i);
+	}
+	const sjtu::cow_vector<int> vc(v);
+	sjtu::cow_vector<int> vv;
+	vv = v;
+	std::cout << v.use_count() << " " << (vc.get().data() == v.get().data()) << std::endl;
+	vv.push_back(-1);
+	std::cout << v.use_count() << " " << vv.use_count() << " " << vv.size() << " " << v.size() << std::endl;
+	v.pop_back();
+	std::cout << vc.use_count() << " " << v.back() << " " << vc.back() << " " << vv.back() << std::endl;
+}
+
+void TestLeakedReference()
+{
+	std::cout << "Testing leaked references..." << std::endl;
+	sjtu::cow_vector<std::string> v;
+	v.push_back("old");
+	std::string &r = v[0];
+	sjtu::cow_vector<std::string> w(v);
+	r = "new";
+	std::cout << v[0] << " " << w.get()[0] << " " << v.use_count() << std::endl;
+	sjtu::cow_vector<std::string> x(w);
+	x.insert(0, x.get()[0]);
+	x.erase(1);
+	x.push_back(x.get()[0]);
+	std::cout << x.size() << " " << x.get()[1] << " " << w.use_count() << std::endl;
+	x.clear();
+	std::cout << x.size() << " " << w.size() << std::endl;
+	try {
+		x.pop_back();
+	} catch(sjtu::container_is_empty &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		w.at(1);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestReads()
+{
+	std::cout << "Testing reads..." << std::endl;
+	sjtu::cow_vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	// reading through read(), cbegin() or get() keeps the buffer shareable
+	long long s = v.read(10) + v.get()[20];
+	for (sjtu::cow_vector<int>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		s += *it;
+	}
+	sjtu::cow_vector<int> w(v);
+	std::cout << s << " " << v.use_count() << " " << (w.get().data() == v.get().data()) << std::endl;
+	// a non-const operator[] may be written through, even if it is not
+	s = v[0];
+	sjtu::cow_vector<int> x(v);
+	std::cout << s << " " << v.use_count() << " " << x.use_count() << " " << (x.get().data() == v.get().data()) << std::endl;
+	try {
+		v.read(100);
+	} catch(sjtu::index_out_of_bound &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestSnapshots()
+{
+	std::cout << "Testing snapshots across threads..." << std::endl;
+	sjtu::cow_vector<long long> config;
+	for (int i = 0; i < 1000; ++i) {
+		config.push_back(i);
+	}
+	std::vector<long long> sums(8);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < 8; ++t) {
+		sjtu::cow_vector<long long> snapshot(config);
+		workers.emplace_back([snapshot, t, &sums]() {
+			long long s = 0;
+			for (int k = 0; k < 100; ++k) {
+				sjtu::cow_vector<long long> again(snapshot);
+				for (sjtu::cow_vector<long long>::const_iterator it = again.cbegin(); it != again.cend(); ++it) {
+					s += *it;
+				}
+			}
+			sums[t] = s;
+		});
+		config.push_back(-1000);
+	}
+	for (auto &th : workers) {
+		th.join();
+	}
+	for (int t = 0; t < 8; ++t) {
+		std::cout << sums[t] << " ";
+	}
+	std::cout << std::endl << config.size() << " " << config.use_count() << std::endl;
+}
+
+int main()
+{
+	TestSharing();
+	TestLeakedReference();
+	TestReads();
+	TestSnapshots();
+	return 0;
+}
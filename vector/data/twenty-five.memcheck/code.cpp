@@ -0,0 +1,114 @@
+#include "mapped_vector.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+struct point {
+	int x;
+	double y;
+};
+
+const char *path = "mapped_vector.test";
+
+void print(const sjtu::mapped_vector<point> &v)
+{
+	long long sx = 0;
+	double sy = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sx += v[i].x;
+		sy += v[i].y;
+	}
+	std::cout << v.size() << " " << sx << " " << sy << " " << v.front().x << " "
+	          << v.back().x << std::endl;
+}
+
+template <typename F> void expect_error(const char *name, F f)
+{
+	try {
+		f();
+		std::cout << name << ": opened" << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << name << ": runtime_error" << std::endl;
+	}
+}
+
+void TestWriteAndReopen()
+{
+	std::cout << "Testing write and reopen..." << std::endl;
+	{
+		sjtu::mapped_vector<point> v(path);
+		std::cout << v.size() << std::endl;
+		for (int i = 0; i < 100000; ++i) {
+			v.push_back(point{i, i * 0.5});
+		}
+		v.insert(0, point{-1, 0});
+		v.erase(v.begin() + 50000);
+		v.emplace_back(point{100000, 1});
+		v.sync();
+		print(v);
+	}
+	{
+		sjtu::mapped_vector<point> v(path);
+		print(v);
+		std::cout << (v.capacity() >= v.size()) << std::endl;
+		v.resize(10);
+		v.shrink_to_fit();
+		v[3].x = 42;
+	}
+	{
+		const sjtu::mapped_vector<point> v(path);
+		print(v);
+		std::cout << v.capacity() << " " << v[3].x << " " << v.at(9).y
+		          << std::endl;
+	}
+	{
+		sjtu::mapped_vector<point> v(path);
+		v.clear();
+		v.reserve(1000);
+	}
+	{
+		sjtu::mapped_vector<point> v(path);
+		std::cout << v.size() << " " << v.empty() << " " << v.capacity()
+		          << std::endl;
+	}
+}
+
+void TestBadFiles()
+{
+	std::cout << "Testing header validation..." << std::endl;
+	{
+		sjtu::mapped_vector<point> v(path);
+		v.push_back(point{1, 2});
+	}
+	// a valid header, but a partial element at the end
+	truncate(path, 64 + sizeof(point) + 3);
+	expect_error("ragged", [] { sjtu::mapped_vector<point> v(path); });
+	truncate(path, 64 + sizeof(point));
+	// elements of another size
+	expect_error("element size", [] { sjtu::mapped_vector<int> v(path); });
+	// more elements recorded than the file holds
+	truncate(path, 64);
+	expect_error("truncated", [] { sjtu::mapped_vector<point> v(path); });
+	// shorter than the header
+	std::ofstream(path, std::ios::trunc) << "hello";
+	expect_error("short", [] { sjtu::mapped_vector<point> v(path); });
+	// not written by mapped_vector
+	std::ofstream(path, std::ios::trunc) << std::string(200, 'x');
+	expect_error("magic", [] { sjtu::mapped_vector<point> v(path); });
+	expect_error("directory", [] { sjtu::mapped_vector<point> v("."); });
+	std::remove(path);
+	expect_error("fresh", [] { sjtu::mapped_vector<point> v(path); });
+}
+
+int main()
+{
+	std::remove(path);
+	TestWriteAndReopen();
+	TestBadFiles();
+	std::remove(path);
+	return 0;
+}
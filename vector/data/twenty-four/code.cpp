@@ -0,0 +1,72 @@
+#include "src/mmap_allocator.hpp"
+#include "src/growth.hpp"
+
+#include <iostream>
+
+template <typename T>
+using tracked_huge_vector = sjtu::vector<T, sjtu::mmap_allocator<T>, sjtu::checked,
+                                         sjtu::tracked_growth<>>;
+
+void TestGrowInPlace()
+{
+	std::cout << "Testing growth in place..." << std::endl;
+	tracked_huge_vector<long long> v;
+	v.push_back(0);
+	// the first granule is committed at once
+	std::cout << v.capacity() << std::endl;
+	for (long long i = 1; i < 3000000; ++i) {
+		v.push_back(i);
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	// moved once, from the first 2 MiB range to a 32 MiB one
+	std::cout << v.size() << " " << sum << " " << v.growth().reallocations
+	          << std::endl;
+	tracked_huge_vector<long long> w(v);
+	w.erase(0);
+	std::cout << w.size() << " " << w.front() << " " << w.back() << std::endl;
+}
+
+void TestMany()
+{
+	std::cout << "Testing many huge vectors..." << std::endl;
+	// each reserves a few MiB, not the whole 64 GiB limit
+	sjtu::vector<sjtu::huge_vector<int>> vs;
+	sjtu::huge_vector<int> one;
+	for (int i = 0; i < 3000; ++i) {
+		one.push_back(i);
+		vs.push_back(one);
+		one.pop_back();
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < vs.size(); ++i) {
+		sum += vs[i].back();
+	}
+	std::cout << vs.size() << " " << sum << std::endl;
+}
+
+void TestSmallLimit()
+{
+	std::cout << "Testing a small limit..." << std::endl;
+	// past 4 MiB the buffers are sized exactly and cannot expand
+	sjtu::vector<int, sjtu::mmap_allocator<int>> v{sjtu::mmap_allocator<int>(size_t(4) << 20)};
+	for (int i = 0; i < 3000000; ++i) {
+		v.push_back(i % 1000);
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << sum << " " << v.get_allocator().reserve()
+	          << std::endl;
+}
+
+int main()
+{
+	TestGrowInPlace();
+	TestMany();
+	TestSmallLimit();
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+static_assert(std::is_same<std::iterator_traits<sjtu::vector<int>::iterator>::iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "iterator is random access");
+static_assert(std::is_same<std::iterator_traits<sjtu::vector<int>::const_iterator>::iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "const_iterator is random access");
+
+void TestAlgorithms()
+{
+	std::cout << "Testing std algorithms..." << std::endl;
+	sjtu::vector<int> v;
+	unsigned seed = 2023;
+	for (int i = 0; i < 10000; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		v.push_back((seed >> 8) % 100000);
+	}
+	std::sort(v.begin(), v.end());
+	std::cout << std::is_sorted(v.begin(), v.end()) << " " << v.front() << " "
+	          << v.back() << std::endl;
+	const sjtu::vector<int> &cv = v;
+	auto it = std::lower_bound(cv.begin(), cv.end(), 50000);
+	std::cout << (it - cv.begin()) << " " << *it << " "
+	          << (*(it - 1) < 50000) << std::endl;
+	std::cout << std::distance(cv.begin(), cv.end()) << " "
+	          << (std::upper_bound(cv.begin(), cv.end(), 99999) == cv.end())
+	          << std::endl;
+	std::sort(v.begin(), v.end(), [](int a, int b) { return a > b; });
+	std::cout << v[0] << " " << v[9999] << std::endl;
+	std::reverse(v.begin(), v.end());
+	std::cout << v[0] << " " << v[9999] << std::endl;
+	sjtu::vector<int> w;
+	for (int i = 0; i < 10; ++i) {
+		w.push_back(i);
+	}
+	std::reverse_iterator<sjtu::vector<int>::iterator> r(w.end());
+	for (; r != std::reverse_iterator<sjtu::vector<int>::iterator>(w.begin()); ++r) {
+		std::cout << *r << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestArithmetic()
+{
+	std::cout << "Testing iterator arithmetic..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::string(i + 1, 'a' + i));
+	}
+	sjtu::vector<std::string>::iterator it = v.begin();
+	it = 3 + it;
+	std::cout << *it << " " << it->size() << " " << it[2] << " " << it[-1]
+	          << std::endl;
+	it += 4;
+	it -= 2;
+	std::cout << *it << " " << (it - v.begin()) << std::endl;
+	sjtu::vector<std::string>::const_iterator cit = it;
+	std::cout << (cit == it) << (cit < v.cend()) << (cit > v.cbegin())
+	          << (cit <= it) << (cit >= v.cend()) << std::endl;
+	std::cout << (v.end() - 1)->size() << " " << *(v.cend() - 10) << std::endl;
+	sjtu::vector<std::string> other(v);
+	try {
+		std::cout << (other.begin() - v.begin()) << std::endl;
+	} catch (const sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator" << std::endl;
+	}
+}
+
+int main()
+{
+	TestAlgorithms();
+	TestArithmetic();
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include "src/allocator.hpp"
+#include "src/vector.hpp"
+
+#include <iostream>
+
+// far past the 4 MiB a loop needs before it is spread over threads
+const size_t N = 2000000;
+
+// not trivially default constructible, but opted in as parallel safe
+struct Cell {
+	int value = 7;
+};
+
+namespace sjtu {
+template <> struct is_parallel_safe<Cell> : std::true_type {};
+}
+
+static_assert(sjtu::is_parallel_safe<int>::value, "");
+static_assert(sjtu::is_parallel_safe<Cell>::value, "");
+static_assert(!sjtu::is_parallel_safe<
+		sjtu::vector<int, sjtu::pool_allocator<int>>>::value, "");
+
+long long sum(const sjtu::vector<int> &v)
+{
+	long long s = 0;
+	for (size_t i = 0; i < v.size(); i++) {
+		s += v[i];
+	}
+	return s;
+}
+
+void TestInts()
+{
+	std::cout << "Testing ints..." << std::endl;
+	sjtu::vector<int> v;
+	v.resize(N, 1);
+	v.resize(2 * N);
+	std::cout << v.size() << " " << sum(v) << std::endl;
+	sjtu::vector<int> w(v);
+	w.insert(w.begin() + 1, N, 2);
+	std::cout << w.size() << " " << sum(w) << " " << w[0] << " " << w[1]
+		<< " " << w[N] << " " << w[N + 1] << std::endl;
+	v = w;
+	v.reserve(4 * N);
+	std::cout << v.size() << " " << sum(v) << std::endl;
+	w = sjtu::vector<int>();
+	w.resize(N, 3);
+	v = w;
+	std::cout << v.size() << " " << sum(v) << std::endl;
+}
+
+void TestOptIn()
+{
+	std::cout << "Testing an opted in type..." << std::endl;
+	sjtu::vector<Cell> v;
+	v.resize(N);
+	sjtu::vector<Cell> w(v);
+	long long s = 0;
+	for (size_t i = 0; i < w.size(); i++) {
+		s += w[i].value;
+	}
+	std::cout << w.size() << " " << s << std::endl;
+}
+
+void TestPool()
+{
+	std::cout << "Testing vectors sharing a pool..." << std::endl;
+	// every copy and destruction allocates from or frees into one pool,
+	// whose free lists are not synchronized
+	sjtu::pool pool;
+	using inner = sjtu::vector<int, sjtu::pool_allocator<int>>;
+	const size_t rows = (size_t(8) << 20) / sizeof(inner);
+	sjtu::vector<inner> v;
+	v.reserve(rows);
+	for (size_t i = 0; i < rows; i++) {
+		inner row{sjtu::pool_allocator<int>(pool)};
+		row.push_back(int(i % 10));
+		v.push_back(std::move(row));
+	}
+	sjtu::vector<inner> w(v);
+	v.clear();
+	sjtu::vector<inner> u(w);
+	long long s = 0;
+	for (size_t i = 0; i < u.size(); i++) {
+		s += u[i][0];
+	}
+	std::cout << (u.size() == rows) << " " << (s == (long long)(rows / 10) * 45
+		+ (long long)((rows % 10) * (rows % 10 - 1) / 2)) << std::endl;
+}
+
+int main()
+{
+	TestInts();
+	TestOptIn();
+	TestPool();
+	return 0;
+}
@@ -0,0 +1,158 @@
+#include "src/vector.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+// a string is written as its length and its characters
+template <> struct sjtu::serializer<std::string> {
+	static void save(std::ostream &os, const std::string &x)
+	{
+		uint64_t n = x.size();
+		os.write(reinterpret_cast<const char *>(&n), sizeof(n));
+		os.write(x.data(), n);
+	}
+	static std::string load(std::istream &is)
+	{
+		uint64_t n = 0;
+		is.read(reinterpret_cast<char *>(&n), sizeof(n));
+		std::string x(is ? n : 0, ' ');
+		is.read(&x[0], x.size());
+		return x;
+	}
+};
+
+struct point {
+	int x;
+	double y;
+};
+
+// a stream that cannot seek, like a pipe
+class pipe_buf : public std::streambuf {
+private:
+	std::string data;
+public:
+	explicit pipe_buf(const std::string &s) : data(s)
+	{
+		setg(&data[0], &data[0], &data[0] + data.size());
+	}
+};
+
+template <typename T> std::string saved(const sjtu::vector<T> &v)
+{
+	std::ostringstream os;
+	v.save(os);
+	return os.str();
+}
+
+// the count follows the endianness tag and the element size
+std::string with_count(std::string s, uint64_t count)
+{
+	memcpy(&s[8], &count, sizeof(count));
+	return s;
+}
+
+template <typename T> void attempt(const char *name, sjtu::vector<T> &v, const std::string &s)
+{
+	std::istringstream is(s);
+	try {
+		v.load(is);
+		std::cout << name << ": loaded " << v.size() << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		std::cout << name << ": runtime_error, size " << v.size() << std::endl;
+	}
+}
+
+void TestRoundTrip()
+{
+	std::cout << "Testing round trips..." << std::endl;
+	sjtu::vector<int> vi;
+	for (int i = 0; i < 1000; ++i) {
+		vi.push_back(i * i);
+	}
+	sjtu::vector<int> wi;
+	wi.push_back(5);
+	attempt("int", wi, saved(vi));
+	std::cout << wi[999] << " " << wi.capacity() << std::endl;
+	sjtu::vector<point> vp;
+	for (int i = 0; i < 10; ++i) {
+		vp.push_back(point{i, i / 4.0});
+	}
+	sjtu::vector<point> wp;
+	attempt("point", wp, saved(vp));
+	std::cout << wp[9].x << " " << wp[9].y << std::endl;
+	sjtu::vector<std::string> vs;
+	for (int i = 0; i < 100; ++i) {
+		vs.push_back(std::string(i, 'a' + i % 26));
+	}
+	sjtu::vector<std::string> ws;
+	attempt("string", ws, saved(vs));
+	std::cout << ws[0].size() << " " << ws[99] << std::endl;
+	sjtu::vector<std::string> empty;
+	attempt("empty", ws, saved(empty));
+}
+
+void TestBadStreams()
+{
+	std::cout << "Testing bad streams..." << std::endl;
+	sjtu::vector<int> vi;
+	for (int i = 0; i < 1000; ++i) {
+		vi.push_back(i);
+	}
+	std::string si = saved(vi);
+	sjtu::vector<int> wi;
+	attempt("truncated int", wi, si.substr(0, si.size() - 10));
+	attempt("bogus int count", wi, with_count(si, uint64_t(1) << 62));
+	attempt("short header", wi, si.substr(0, 10));
+	wi.push_back(7);
+	sjtu::vector<long long> wl;
+	wl.push_back(7);
+	attempt("other type", wl, si);
+	std::cout << wl.size() << " " << wl[0] << std::endl;
+	sjtu::vector<std::string> vs;
+	for (int i = 0; i < 10; ++i) {
+		vs.push_back(std::string(100, 'x'));
+	}
+	std::string ss = saved(vs);
+	sjtu::vector<std::string> ws;
+	attempt("truncated string", ws, ss.substr(0, ss.size() - 50));
+	attempt("bogus string count", ws, with_count(ss, uint64_t(1) << 62));
+	attempt("string after", ws, ss);
+}
+
+void TestPipe()
+{
+	std::cout << "Testing unseekable streams..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000000; ++i) {
+		v.push_back(i);
+	}
+	std::string s = saved(v);
+	sjtu::vector<int> w;
+	{
+		pipe_buf buf(s);
+		std::istream is(&buf);
+		w.load(is);
+		std::cout << w.size() << " " << w[999999] << std::endl;
+	}
+	{
+		pipe_buf buf(with_count(s, uint64_t(1) << 62));
+		std::istream is(&buf);
+		try {
+			w.load(is);
+		} catch (const sjtu::runtime_error &) {
+			std::cout << "runtime_error, size " << w.size() << std::endl;
+		}
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestBadStreams();
+	TestPipe();
+	return 0;
+}
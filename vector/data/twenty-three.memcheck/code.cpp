@@ -0,0 +1,71 @@
+#include "vector.hpp"
+#include "growth.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+template <typename Growth>
+using grown_vector = sjtu::vector<int, std::allocator<int>, sjtu::checked, Growth>;
+
+template <typename V> void capacities(V &v, int n)
+{
+	size_t last = v.capacity();
+	std::cout << last;
+	for (int i = 0; i < n; ++i) {
+		v.push_back(i);
+		if (v.capacity() != last) {
+			last = v.capacity();
+			std::cout << " " << last;
+		}
+	}
+	std::cout << std::endl;
+}
+
+void TestPolicies()
+{
+	std::cout << "Testing growth policies..." << std::endl;
+	grown_vector<sjtu::geometric_growth<>> g;
+	capacities(g, 100);
+	grown_vector<sjtu::geometric_growth<2, 1, 1>> d;
+	capacities(d, 100);
+	grown_vector<sjtu::fixed_growth<32>> f;
+	capacities(f, 100);
+	// ints are 4 bytes: powers of two up to a page, then whole pages
+	grown_vector<sjtu::page_growth<>> p;
+	capacities(p, 5000);
+}
+
+void TestTracked()
+{
+	std::cout << "Testing tracked growth..." << std::endl;
+	grown_vector<sjtu::tracked_growth<sjtu::fixed_growth<10>>> v;
+	for (int i = 0; i < 35; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.growth().reallocations << " " << v.growth().bytes_relocated
+	          << " " << v.growth().peak_capacity << std::endl;
+	v.reserve(100);
+	v.shrink_to_fit();
+	std::cout << v.growth().reallocations << " " << v.growth().bytes_relocated
+	          << " " << v.growth().peak_capacity << std::endl;
+	// a copy starts with fresh counters
+	grown_vector<sjtu::tracked_growth<sjtu::fixed_growth<10>>> w(v);
+	std::cout << w.size() << " " << w.growth().reallocations << " "
+	          << w.growth().peak_capacity << std::endl;
+	sjtu::vector<std::string, std::allocator<std::string>, sjtu::checked,
+	             sjtu::tracked_growth<>> s;
+	for (int i = 0; i < 1000; ++i) {
+		s.push_back(std::to_string(i));
+	}
+	std::cout << s.growth().reallocations << " "
+	          << s.growth().bytes_relocated / sizeof(std::string) << " "
+	          << s.growth().peak_capacity << " " << s.capacity() << std::endl;
+}
+
+int main()
+{
+	TestPolicies();
+	TestTracked();
+	return 0;
+}
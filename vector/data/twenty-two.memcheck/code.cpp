@@ -0,0 +1,84 @@
+#include "vector.hpp"
+#include "small_vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+using fast_vector = sjtu::vector<int, std::allocator<int>, sjtu::unchecked>;
+
+// an unchecked iterator is a bare pointer, a checked one also remembers its vector
+static_assert(sizeof(fast_vector::iterator) == sizeof(int *), "unchecked iterator");
+static_assert(sizeof(fast_vector::const_iterator) == sizeof(int *), "unchecked const_iterator");
+static_assert(sizeof(sjtu::vector<int>::iterator) == 2 * sizeof(int *), "checked iterator");
+#if __cplusplus > 201703L
+static_assert(std::contiguous_iterator<fast_vector::iterator>);
+static_assert(std::contiguous_iterator<fast_vector::const_iterator>);
+static_assert(std::contiguous_iterator<sjtu::vector<int>::iterator>);
+#endif
+
+void TestUnchecked()
+{
+	std::cout << "Testing unchecked vectors..." << std::endl;
+	fast_vector v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i * 3 % 1000);
+	}
+	std::sort(v.begin(), v.end());
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	v[10] = -10;
+	std::cout << sum << " " << v[10] << " " << *(v.begin() + 999) << std::endl;
+	// at() checks under both policies
+	try {
+		v.at(1000);
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	const fast_vector &cv = v;
+	std::cout << (cv.end() - cv.begin()) << " " << cv[999] << std::endl;
+}
+
+void TestChecked()
+{
+	std::cout << "Testing checked vectors..." << std::endl;
+	sjtu::vector<int> v, w;
+	v.push_back(1);
+	w.push_back(2);
+	try {
+		v[1];
+	} catch (const sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	try {
+		std::cout << (v.end() - w.begin()) << std::endl;
+	} catch (const sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator" << std::endl;
+	}
+}
+
+void TestSmallVector()
+{
+	std::cout << "Testing unchecked small vectors..." << std::endl;
+	sjtu::small_vector<std::string, 4, sjtu::unchecked> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	std::string all;
+	for (auto it = v.begin(); it != v.end(); ++it) {
+		all += *it;
+	}
+	std::cout << all << " " << v[9] << std::endl;
+}
+
+int main()
+{
+	TestUnchecked();
+	TestChecked();
+	TestSmallVector();
+	return 0;
+}
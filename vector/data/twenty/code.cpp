@@ -0,0 +1,78 @@
+#include "src/vector.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+
+void print(const sjtu::vector<int> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestRange()
+{
+	std::cout << "Testing range insert and erase..." << std::endl;
+	sjtu::vector<int> v, w;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+		w.push_back(100 + i);
+	}
+	v.insert(v.begin() + 3, w.begin(), w.begin() + 4);
+	print(v);
+	v.insert(v.begin(), 3, 7);
+	print(v);
+	v.erase(v.begin() + 2, v.begin() + 9);
+	print(v);
+	v.erase(v.begin(), v.begin());
+	print(v);
+	try {
+		v.erase(20);
+	} catch(...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestOtherIterators()
+{
+	std::cout << "Testing other iterators..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i);
+	}
+	std::list<int> l = {10, 11, 12};
+	v.insert(2, l.begin(), l.end());
+	print(v);
+	// read once, so the values cannot be counted before they are stored
+	std::istringstream in("20 21 22 23 24 25");
+	v.insert(v.begin() + 1, std::istream_iterator<int>(in),
+	         std::istream_iterator<int>());
+	print(v);
+	std::istringstream empty("");
+	v.insert(0, std::istream_iterator<int>(empty), std::istream_iterator<int>());
+	std::istringstream more("30 31");
+	v.insert(v.end(), std::istream_iterator<int>(more),
+	         std::istream_iterator<int>());
+	print(v);
+	sjtu::vector<std::string> s;
+	s.push_back("a");
+	s.push_back("z");
+	std::istringstream words("b c d e f g h i j k");
+	s.insert(1, std::istream_iterator<std::string>(words),
+	         std::istream_iterator<std::string>());
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i];
+	}
+	std::cout << " " << s.size() << std::endl;
+}
+
+int main()
+{
+	TestRange();
+	TestOtherIterators();
+	return 0;
+}
@@ -0,0 +1,229 @@
+#ifndef SJTU_ALLOCATOR_HPP
+#define SJTU_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * the result of allocate_at_least: the memory got and the number of elements
+ * it has room for, which may be more than requested
+ */
+template <typename Pointer> struct allocation_result {
+  Pointer ptr;
+  size_t count;
+};
+
+/**
+ * whether Alloc provides allocate_at_least(n) returning an
+ * allocation_result. containers use it to learn the real capacity.
+ */
+template <typename Alloc, typename = void>
+struct has_allocate_at_least : std::false_type {};
+template <typename Alloc>
+struct has_allocate_at_least<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().allocate_at_least(
+               size_t()))>> : std::true_type {};
+
+/**
+ * whether Alloc provides bool expand_in_place(T *p, size_t n, size_t newn),
+ * growing the buffer p of n elements to newn without moving it, or returning
+ * false if it cannot
+ */
+template <typename Alloc, typename = void>
+struct has_expand_in_place : std::false_type {};
+template <typename Alloc>
+struct has_expand_in_place<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().expand_in_place(
+               std::declval<typename Alloc::value_type *>(), size_t(),
+               size_t()))>> : std::true_type {};
+
+/**
+ * a monotonic memory resource.
+ * memory is carved from big chunks by bumping a pointer, deallocate does
+ * nothing, and reset() gives everything back at once.
+ */
+class arena {
+private:
+  struct chunk {
+    chunk *next;
+    size_t size;
+  };
+  // the payload of a chunk starts at this offset, keeping max alignment
+  static const size_t HEADER =
+      (sizeof(chunk) + alignof(std::max_align_t) - 1) &
+      ~(alignof(std::max_align_t) - 1);
+
+  chunk *head;      // the newest (and biggest) chunk
+  char *cur, *end;  // free space in head
+  size_t next_size; // payload size of the next chunk
+
+  static char *align_up(char *p, size_t align) {
+    uintptr_t x = reinterpret_cast<uintptr_t>(p);
+    return p + ((align - x % align) % align);
+  }
+
+  /**
+   * @brief start a new chunk with room for at least bytes
+   */
+  void grow(size_t bytes) {
+    while (next_size < bytes) {
+      next_size *= 2;
+    }
+    chunk *c = static_cast<chunk *>(::operator new(HEADER + next_size));
+    c->next = head;
+    c->size = next_size;
+    head = c;
+    cur = reinterpret_cast<char *>(c) + HEADER;
+    end = cur + next_size;
+    next_size *= 2;
+  }
+
+  /**
+   * @brief free the chunks from c on
+   */
+  static void free_chunks(chunk *c) {
+    while (c != nullptr) {
+      chunk *next = c->next;
+      ::operator delete(c);
+      c = next;
+    }
+  }
+
+public:
+  explicit arena(size_t initial = 4096)
+      : head(nullptr), cur(nullptr), end(nullptr), next_size(initial) {}
+  arena(const arena &) = delete;
+  arena &operator=(const arena &) = delete;
+  ~arena() { free_chunks(head); }
+
+  void *allocate(size_t bytes, size_t align) {
+    char *p = align_up(cur, align);
+    if (cur == nullptr || p + bytes > end) {
+      grow(bytes + align);
+      p = align_up(cur, align);
+    }
+    cur = p + bytes;
+    return p;
+  }
+  void deallocate(void *, size_t, size_t) {}
+  /**
+   * frees all the memory allocated so far, only the newest chunk is kept
+   * for reuse. anything still holding memory from the arena must not touch
+   * it afterwards.
+   */
+  void reset() {
+    if (head == nullptr) {
+      return;
+    }
+    free_chunks(head->next);
+    head->next = nullptr;
+    cur = reinterpret_cast<char *>(head) + HEADER;
+    end = cur + head->size;
+  }
+};
+
+/**
+ * a memory resource of size classes (powers of two from 16 B to 64 KB).
+ * a freed block goes to the free list of its class and is reused by the next
+ * allocation of that class. blocks are carved from an arena, bigger requests
+ * go to operator new directly.
+ */
+class pool {
+private:
+  static const size_t MIN_SHIFT = 4;
+  static const size_t MAX_SHIFT = 16;
+  static const size_t CLASSES = MAX_SHIFT - MIN_SHIFT + 1;
+
+  struct node {
+    node *next;
+  };
+  node *free_list[CLASSES];
+  arena blocks;
+
+  /**
+   * @brief the size class for a block of bytes aligned to align
+   */
+  static size_t size_class(size_t bytes, size_t align) {
+    size_t need = bytes > align ? bytes : align, k = 0;
+    while ((size_t(1) << (k + MIN_SHIFT)) < need) {
+      k++;
+    }
+    return k;
+  }
+
+public:
+  explicit pool(size_t initial = 65536) : free_list(), blocks(initial) {}
+  pool(const pool &) = delete;
+  pool &operator=(const pool &) = delete;
+
+  void *allocate(size_t bytes, size_t align) {
+    size_t k = size_class(bytes, align);
+    if (k >= CLASSES) {
+      return ::operator new(bytes, std::align_val_t(align));
+    }
+    if (free_list[k] != nullptr) {
+      node *p = free_list[k];
+      free_list[k] = p->next;
+      return p;
+    }
+    size_t size = size_t(1) << (k + MIN_SHIFT);
+    return blocks.allocate(size, align > alignof(node) ? align : alignof(node));
+  }
+  void deallocate(void *p, size_t bytes, size_t align) {
+    size_t k = size_class(bytes, align);
+    if (k >= CLASSES) {
+      ::operator delete(p, std::align_val_t(align));
+      return;
+    }
+    node *n = static_cast<node *>(p);
+    n->next = free_list[k];
+    free_list[k] = n;
+  }
+};
+
+/**
+ * an allocator getting memory from a resource such as arena or pool.
+ * the resource must outlive every container using it.
+ */
+template <typename T, typename Resource> class resource_allocator {
+  template <typename U, typename R> friend class resource_allocator;
+
+private:
+  Resource *res;
+
+public:
+  using value_type = T;
+
+  explicit resource_allocator(Resource &r) noexcept : res(&r) {}
+  template <typename U>
+  resource_allocator(const resource_allocator<U, Resource> &other) noexcept
+      : res(other.res) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(res->allocate(sizeof(T) * n, alignof(T)));
+  }
+  void deallocate(T *p, size_t n) {
+    res->deallocate(p, sizeof(T) * n, alignof(T));
+  }
+  Resource *resource() const { return res; }
+
+  template <typename U>
+  bool operator==(const resource_allocator<U, Resource> &rhs) const {
+    return res == rhs.res;
+  }
+  template <typename U>
+  bool operator!=(const resource_allocator<U, Resource> &rhs) const {
+    return res != rhs.res;
+  }
+};
+
+template <typename T> using arena_allocator = resource_allocator<T, arena>;
+template <typename T> using pool_allocator = resource_allocator<T, pool>;
+
+} // namespace sjtu
+
+#endif
@@ -0,0 +1,345 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * an append-only vector that many threads can push_back to at once.
+ * the blocks are laid out as in stable_vector: block k holds 2^(Shift + k)
+ * elements and no element ever moves, so there is no expand() to serialize
+ * on. a push_back installs the block of the next slot with a
+ * compare-and-swap if nobody has yet, takes the slot from an atomic counter,
+ * constructs the element and marks it ready. size() only counts the prefix
+ * of ready elements, so a reader never sees a slot whose element is still
+ * being constructed.
+ * push_back, emplace_back, reserve, size, at and [] may run concurrently.
+ * clear and the destructor must not race with anything.
+ * the element is built and its block allocated before a slot is taken, so
+ * neither a throwing constructor nor a failed allocation can leave a hole
+ * in the prefix; this needs a noexcept move.
+ */
+template <typename T, typename Allocator = std::allocator<T>, size_t Shift = 4>
+class concurrent_vector {
+  static_assert(std::is_nothrow_move_constructible<T>::value,
+                "concurrent_vector needs a noexcept move constructor");
+
+private:
+  struct cell {
+    std::atomic<bool> ready;
+    alignas(T) unsigned char data[sizeof(T)];
+
+    cell() : ready(false) {}
+    T *get() { return reinterpret_cast<T *>(data); }
+  };
+
+  using cell_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<cell>;
+  using traits = std::allocator_traits<cell_allocator>;
+  static const size_t BLOCKS = sizeof(size_t) * 8 - Shift;
+
+  std::atomic<cell *> blocks[BLOCKS]; // nullptr for blocks not allocated yet
+  std::atomic<size_t> reserved;       // number of slots handed out
+  std::atomic<size_t> published;      // length of the ready prefix
+  cell_allocator alloc;               // allocator
+
+  static size_t block_size(size_t k) { return size_t(1) << (Shift + k); }
+
+  /**
+   * @brief the index of the highest set bit of x > 0
+   */
+  static size_t log2(size_t x) {
+#if defined(__GNUC__)
+    return sizeof(unsigned long long) * 8 - 1 -
+           __builtin_clzll((unsigned long long)x);
+#else
+    size_t r = 0;
+    while (x >>= 1) {
+      r++;
+    }
+    return r;
+#endif
+  }
+
+  static void locate(size_t pos, size_t &k, size_t &off) {
+    size_t x = pos + block_size(0);
+    k = log2(x) - Shift;
+    off = x - block_size(k);
+  }
+
+  /**
+   * @brief the cell of slot pos, or nullptr if its block is not there yet
+   */
+  cell *find(size_t pos) const {
+    size_t k, off;
+    locate(pos, k, off);
+    cell *b = blocks[k].load(std::memory_order_acquire);
+    return b ? b + off : nullptr;
+  }
+
+  T *slot(size_t pos) const { return find(pos)->get(); }
+
+  /**
+   * @brief install block k if no other thread has done so
+   */
+  cell *install(size_t k) {
+    cell *b = blocks[k].load(std::memory_order_acquire);
+    if (b) {
+      return b;
+    }
+    cell *fresh = traits::allocate(alloc, block_size(k));
+    for (size_t i = 0; i < block_size(k); i++) {
+      ::new (fresh + i) cell();
+    }
+    if (blocks[k].compare_exchange_strong(b, fresh,
+                                          std::memory_order_acq_rel)) {
+      return fresh;
+    }
+    // lost the race, b now holds the winner's block
+    traits::deallocate(alloc, fresh, block_size(k));
+    return b;
+  }
+
+  /**
+   * @brief take the next slot. its block is installed before the slot is
+   * taken, so an allocation that throws leaves no slot behind that would
+   * never be filled and would stop the ready prefix for good.
+   */
+  size_t claim() {
+    size_t pos = reserved.load();
+    for (;;) {
+      size_t k, off;
+      locate(pos, k, off);
+      install(k);
+      // on failure pos is reloaded, and its block is checked again
+      if (reserved.compare_exchange_weak(pos, pos + 1)) {
+        return pos;
+      }
+    }
+  }
+
+  /**
+   * @brief extend the ready prefix as far as it goes.
+   * every thread that marks a slot ready calls this afterwards, so the one
+   * that fills the last gap always carries the prefix over the slots that
+   * became ready before it.
+   */
+  void publish() {
+    size_t p = published.load();
+    for (;;) {
+      cell *c = find(p);
+      if (!c || !c->ready.load()) {
+        return;
+      }
+      // on failure p is reloaded and the scan goes on from there
+      published.compare_exchange_weak(p, p + 1);
+    }
+  }
+
+  template <bool Const> class basic_iterator {
+    friend class concurrent_vector;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    using owner_type = std::conditional_t<Const, const concurrent_vector *,
+                                          concurrent_vector *>;
+    owner_type owner;
+    size_t pos;
+
+    basic_iterator(owner_type o, size_t p) : owner(o), pos(p) {}
+
+  public:
+    basic_iterator() : owner(nullptr), pos(0) {}
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &it) : owner(it.owner), pos(it.pos) {}
+
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(owner, pos + n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(owner, pos - n);
+    }
+    // return the distance between two iterators,
+    // if these two iterators point to different vectors, throw
+    // invaild_iterator.
+    difference_type operator-(const basic_iterator &rhs) const {
+      if (owner != rhs.owner) {
+        throw invalid_iterator();
+      }
+      return difference_type(pos - rhs.pos);
+    }
+    basic_iterator &operator+=(difference_type n) {
+      pos += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      pos -= n;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      pos++;
+      return tmp;
+    }
+    basic_iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      pos--;
+      return tmp;
+    }
+    basic_iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    reference operator*() const { return *owner->slot(pos); }
+    pointer operator->() const { return owner->slot(pos); }
+    reference operator[](difference_type n) const {
+      return *owner->slot(pos + n);
+    }
+    bool operator==(const basic_iterator &rhs) const {
+      return owner == rhs.owner && pos == rhs.pos;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return pos < rhs.pos; }
+    bool operator>(const basic_iterator &rhs) const { return pos > rhs.pos; }
+    bool operator<=(const basic_iterator &rhs) const { return pos <= rhs.pos; }
+    bool operator>=(const basic_iterator &rhs) const { return pos >= rhs.pos; }
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  concurrent_vector() : blocks(), reserved(0), published(0) {}
+  explicit concurrent_vector(const Allocator &a)
+      : blocks(), reserved(0), published(0), alloc(a) {}
+  concurrent_vector(const concurrent_vector &) = delete;
+  concurrent_vector &operator=(const concurrent_vector &) = delete;
+  /**
+   * Destructor
+   */
+  ~concurrent_vector() {
+    clear();
+    for (size_t k = 0; k < BLOCKS; k++) {
+      cell *b = blocks[k].load();
+      if (b) {
+        traits::deallocate(alloc, b, block_size(k));
+      }
+    }
+  }
+  /**
+   * assigns specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return *slot(pos);
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return *slot(pos);
+  }
+  T &operator[](const size_t &pos) { return at(pos); }
+  const T &operator[](const size_t &pos) const { return at(pos); }
+  /**
+   * iterators cover the prefix that was ready when end() was called
+   */
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(this, size()); }
+  bool empty() const { return !size(); }
+  /**
+   * returns the number of elements that are fully constructed and visible
+   * to every thread. elements still being pushed are not counted.
+   */
+  size_t size() const { return published.load(std::memory_order_acquire); }
+  /**
+   * returns the number of elements the allocated blocks hold
+   */
+  size_t capacity() const {
+    size_t k = 0;
+    while (k < BLOCKS && blocks[k].load(std::memory_order_acquire)) {
+      k++;
+    }
+    return block_size(k) - block_size(0);
+  }
+  /**
+   * allocates the blocks for the first n elements
+   */
+  void reserve(const size_t &n) {
+    if (n > 0) {
+      size_t k, off;
+      locate(n - 1, k, off);
+      for (size_t i = 0; i <= k; i++) {
+        install(i);
+      }
+    }
+  }
+  /**
+   * clears the contents, the blocks are kept for later insertions.
+   * not safe to call while other threads use the vector.
+   */
+  void clear() {
+    size_t n = reserved.load();
+    for (size_t i = 0; i < n; i++) {
+      // only ready slots hold an element
+      cell *c = find(i);
+      if (c && c->ready.load(std::memory_order_relaxed)) {
+        c->get()->~T();
+        c->ready.store(false, std::memory_order_relaxed);
+      }
+    }
+    reserved.store(0);
+    published.store(0);
+  }
+  /**
+   * adds an element to the end and returns its index.
+   * the element counts in size() once every element before it is ready too.
+   */
+  size_t push_back(const T &value) { return emplace_back(value); }
+  size_t push_back(T &&value) { return emplace_back(std::move(value)); }
+  /**
+   * constructs an element from args at the end and returns its index.
+   */
+  template <typename... Args> size_t emplace_back(Args &&...args) {
+    T value(std::forward<Args>(args)...);
+    size_t pos = claim();
+    cell *c = find(pos);
+    ::new (c->get()) T(std::move(value));
+    c->ready.store(true);
+    publish();
+    return pos;
+  }
+};
+
+} // namespace sjtu
+
+#endif
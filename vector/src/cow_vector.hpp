@@ -0,0 +1,251 @@
+#ifndef SJTU_COW_VECTOR_HPP
+#define SJTU_COW_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a copy-on-write vector: copies share one buffer with a reference count,
+ * and the buffer is cloned when a copy that shares it is first modified.
+ * copying, assigning and passing by value are O(1), reading never clones.
+ * the count is atomic, so copies may be made and dropped on different
+ * threads, e.g. a snapshot handed to a worker while the owner keeps going.
+ * the usual rules for a single object still hold: one cow_vector must not be
+ * modified while another thread uses that same object.
+ *
+ * a non-const at(), operator[], begin(), end(), data() or emplace_back()
+ * hands out a way to write into the buffer later, even if the caller only
+ * reads through it. such a buffer is marked unshareable for good and every
+ * later copy deep-copies it, or a write through the old reference would show
+ * up in the copy. to read a non-const cow_vector without that cost, use
+ * read(), cbegin() and cend(), get(), or the const overloads through a const
+ * reference. push_back and the other modifiers keep the buffer shareable.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class cow_vector {
+public:
+  using vector_type = vector<T, Allocator>;
+  using iterator = typename vector_type::iterator;
+  using const_iterator = typename vector_type::const_iterator;
+
+private:
+  struct body {
+    std::atomic<size_t> refs;
+    bool shareable; // false once a mutable reference has been handed out
+    vector_type data;
+
+    explicit body(const vector_type &v) : refs(1), shareable(true), data(v) {}
+  };
+
+  body *b; // nullptr while empty and never modified
+
+  static body *share(body *p) {
+    if (p == nullptr) {
+      return nullptr;
+    }
+    if (!p->shareable) {
+      return new body(p->data);
+    }
+    p->refs.fetch_add(1, std::memory_order_relaxed);
+    return p;
+  }
+
+  void drop() {
+    if (b != nullptr && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete b;
+    }
+    b = nullptr;
+  }
+
+  /**
+   * @brief the buffer, owned by this vector alone, for modifying
+   */
+  vector_type &mut() {
+    if (b == nullptr) {
+      b = new body(vector_type());
+    } else if (b->refs.load(std::memory_order_acquire) > 1) {
+      body *p = new body(b->data);
+      drop();
+      b = p;
+    }
+    return b->data;
+  }
+
+  /**
+   * @brief as mut(), for a caller that lets a reference escape
+   */
+  vector_type &leak() {
+    vector_type &v = mut();
+    b->shareable = false;
+    return v;
+  }
+
+  static const vector_type &empty_vector() {
+    static const vector_type v;
+    return v;
+  }
+
+public:
+  cow_vector() : b(nullptr) {}
+  /**
+   * copies the elements of v into a fresh buffer
+   */
+  explicit cow_vector(const vector_type &v) : b(new body(v)) {}
+  /**
+   * shares the buffer of other, O(1)
+   */
+  cow_vector(const cow_vector &other) : b(share(other.b)) {}
+  /**
+   * Destructor
+   */
+  ~cow_vector() { drop(); }
+  /**
+   * Assignment operator, shares the buffer of other, O(1)
+   */
+  cow_vector &operator=(const cow_vector &other) {
+    if (this != &other && b != other.b) {
+      body *p = share(other.b);
+      drop();
+      b = p;
+    }
+    return *this;
+  }
+  /**
+   * the elements as a plain vector
+   */
+  const vector_type &get() const { return b ? b->data : empty_vector(); }
+  /**
+   * the number of cow_vectors sharing this buffer, 0 if there is none
+   */
+  size_t use_count() const {
+    return b ? b->refs.load(std::memory_order_relaxed) : 0;
+  }
+  /**
+   * reads specified element with bounds checking, the buffer stays
+   * shareable.
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  const T &read(const size_t &pos) const { return get().at(pos); }
+  /**
+   * assigns specified element with bounds checking, which makes the buffer
+   * unshareable; use read() to only read it.
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return leak()[pos];
+  }
+  const T &at(const size_t &pos) const { return get().at(pos); }
+  T &operator[](const size_t &pos) { return at(pos); }
+  const T &operator[](const size_t &pos) const { return get()[pos]; }
+  /**
+   * access the first element.
+   * throw container_is_empty if size == 0
+   */
+  const T &front() const { return get().front(); }
+  /**
+   * access the last element.
+   * throw container_is_empty if size == 0
+   */
+  const T &back() const { return get().back(); }
+  T *data() { return leak().data(); }
+  const T *data() const { return get().data(); }
+  iterator begin() { return leak().begin(); }
+  const_iterator begin() const { return get().begin(); }
+  const_iterator cbegin() const { return get().cbegin(); }
+  iterator end() { return leak().end(); }
+  const_iterator end() const { return get().end(); }
+  const_iterator cend() const { return get().cend(); }
+  bool empty() const { return get().empty(); }
+  size_t size() const { return get().size(); }
+  size_t capacity() const { return get().capacity(); }
+  void reserve(const size_t &n) { mut().reserve(n); }
+  void resize(const size_t &n) { mut().resize(n); }
+  void resize(const size_t &n, const T &value) { mut().resize(n, value); }
+  void shrink_to_fit() { mut().shrink_to_fit(); }
+  /**
+   * clears the contents. a shared buffer is not cloned for this, this vector
+   * just lets go of it.
+   */
+  void clear() {
+    if (use_count() > 1) {
+      drop();
+    } else if (b != nullptr) {
+      b->data.clear();
+    }
+  }
+  /**
+   * inserts value at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  void insert(const size_t &ind, const T &value) {
+    if (ind > size()) {
+      throw index_out_of_bound();
+    }
+    // a clone leaves the old buffer to its other owners, so value stays valid
+    mut().insert(ind, value);
+  }
+  /**
+   * removes the element with index ind.
+   * throw index_out_of_bound if ind >= size
+   */
+  void erase(const size_t &ind) {
+    if (ind >= size()) {
+      throw index_out_of_bound();
+    }
+    mut().erase(ind);
+  }
+  /**
+   * removes the element with index ind in O(1), moving the last element into
+   * its place.
+   * throw index_out_of_bound if ind >= size
+   */
+  void swap_remove(const size_t &ind) {
+    if (ind >= size()) {
+      throw index_out_of_bound();
+    }
+    mut().swap_remove(ind);
+  }
+  /**
+   * removes every element for which pred returns true, keeping the order.
+   * return the number of removed elements.
+   */
+  template <typename Pred> size_t erase_if(Pred pred) {
+    return empty() ? 0 : mut().erase_if(pred);
+  }
+  /**
+   * adds an element to the end.
+   */
+  void push_back(const T &value) { mut().push_back(value); }
+  void push_back(T &&value) { mut().push_back(std::move(value)); }
+  /**
+   * constructs an element from args at the end.
+   * returns a reference to the new element, which makes the buffer
+   * unshareable; push_back keeps it shareable.
+   */
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    return leak().emplace_back(std::forward<Args>(args)...);
+  }
+  /**
+   * remove the last element from the end.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    mut().pop_back();
+  }
+};
+
+} // namespace sjtu
+
+#endif
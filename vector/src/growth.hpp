@@ -0,0 +1,86 @@
+#ifndef SJTU_GROWTH_HPP
+#define SJTU_GROWTH_HPP
+
+#include <cstddef>
+
+namespace sjtu {
+/**
+ * growth policies of vector.
+ * a vector derives from its policy and asks it for the new capacity whenever
+ * the buffer is too small:
+ * @code{size_t next_capacity(size_t siz, size_t need, size_t elem_size)}
+ * returns a capacity of at least need for a vector of siz elements, each of
+ * elem_size bytes, and
+ * @code{void record_reallocation(size_t newcap, size_t bytes)}
+ * is called after each reallocation, with the bytes of elements relocated.
+ */
+
+/**
+ * capacity becomes siz * Num / Den + Min
+ */
+template <size_t Num = 3, size_t Den = 2, size_t Min = 3>
+struct geometric_growth {
+  static size_t next_capacity(size_t siz, size_t need, size_t) {
+    size_t newcap = siz * Num / Den + Min;
+    return newcap < need ? need : newcap;
+  }
+  void record_reallocation(size_t, size_t) {}
+};
+
+/**
+ * capacity becomes siz + Step
+ */
+template <size_t Step = 1024> struct fixed_growth {
+  static size_t next_capacity(size_t siz, size_t need, size_t) {
+    size_t newcap = siz + Step;
+    return newcap < need ? need : newcap;
+  }
+  void record_reallocation(size_t, size_t) {}
+};
+
+/**
+ * takes the capacity from Inner and rounds the buffer up to what the
+ * allocator hands out anyway: a power of two below Page bytes, and a
+ * multiple of Page above, so no slack in a size class or page is wasted
+ */
+template <typename Inner = geometric_growth<>, size_t Page = 4096>
+struct page_growth {
+  static size_t next_capacity(size_t siz, size_t need, size_t elem_size) {
+    size_t bytes = Inner::next_capacity(siz, need, elem_size) * elem_size;
+    if (bytes < Page) {
+      size_t rounded = 16;
+      while (rounded < bytes) {
+        rounded *= 2;
+      }
+      bytes = rounded;
+    } else {
+      bytes = (bytes + Page - 1) / Page * Page;
+    }
+    return bytes / elem_size;
+  }
+  void record_reallocation(size_t, size_t) {}
+};
+
+/**
+ * grows as Inner does and counts what the growth costs
+ */
+template <typename Inner = geometric_growth<>> struct tracked_growth {
+  size_t reallocations = 0;   // times the buffer was replaced
+  size_t bytes_relocated = 0; // bytes of elements moved or copied meanwhile
+  size_t peak_capacity = 0;   // largest capacity reached
+
+  static size_t next_capacity(size_t siz, size_t need, size_t elem_size) {
+    return Inner::next_capacity(siz, need, elem_size);
+  }
+  void record_reallocation(size_t newcap, size_t bytes) {
+    reallocations++;
+    bytes_relocated += bytes;
+    if (newcap > peak_capacity) {
+      peak_capacity = newcap;
+    }
+  }
+};
+
+} // namespace sjtu
+
+#endif
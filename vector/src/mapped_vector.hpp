@@ -0,0 +1,335 @@
+#ifndef SJTU_MAPPED_VECTOR_HPP
+#define SJTU_MAPPED_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "growth.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sjtu {
+/**
+ * a vector of trivially copyable elements stored in a file through mmap.
+ * the file holds a small header (magic, element size, size) followed by the
+ * elements, so opening an existing file only maps it: no element is read or
+ * copied until it is touched. growing extends the file with ftruncate and
+ * remaps it.
+ * the interface, iterators and exceptions are those of sjtu::vector, except
+ * that it cannot be copied. runtime_error is thrown when the file cannot be
+ * opened, mapped or resized, holds elements of another size, or is not a
+ * whole number of elements long.
+ */
+template <typename T, typename Growth = geometric_growth<>>
+class mapped_vector : private Growth {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "mapped_vector needs trivially copyable elements");
+
+private:
+  struct header {
+    uint64_t magic;
+    uint64_t elem_size;
+    uint64_t size;
+  };
+  static const uint64_t MAGIC = 0x31564d554a545373; // identifies the format
+  // the elements start at this offset, keeping them cache-line aligned
+  static const size_t OFFSET = 64;
+
+  int fd;
+  char *base; // the mapping, header included
+  T *arr;     // array
+  size_t siz; // size
+  size_t cap; // capacity
+
+  header *head() const { return reinterpret_cast<header *>(base); }
+  static size_t file_size(size_t n) { return OFFSET + sizeof(T) * n; }
+
+  /**
+   * @brief resize the file and the mapping to hold newcap elements
+   */
+  void remap(size_t newcap) {
+    if (ftruncate(fd, file_size(newcap)) != 0) {
+      throw runtime_error();
+    }
+#ifdef __linux__
+    void *p = mremap(base, file_size(cap), file_size(newcap), MREMAP_MAYMOVE);
+#else
+    munmap(base, file_size(cap));
+    void *p = mmap(nullptr, file_size(newcap), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+#endif
+    if (p == MAP_FAILED) {
+      throw runtime_error();
+    }
+    base = static_cast<char *>(p);
+    arr = reinterpret_cast<T *>(base + OFFSET);
+    cap = newcap;
+  }
+
+  /**
+   * @brief make room for n more elements
+   */
+  void expand(size_t n = 1) {
+    if (siz + n > cap) {
+      remap(Growth::next_capacity(siz, siz + n, sizeof(T)));
+    }
+  }
+
+  void set_size(size_t n) { siz = head()->size = n; }
+
+public:
+  using iterator = typename vector<T>::iterator;
+  using const_iterator = typename vector<T>::const_iterator;
+
+  /**
+   * opens the vector stored in the file at path, creating an empty one if
+   * the file does not exist
+   */
+  explicit mapped_vector(const char *path) {
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+      throw runtime_error();
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw runtime_error();
+    }
+    size_t bytes = st.st_size;
+    bool fresh = bytes == 0;
+    if (fresh) {
+      bytes = file_size(0);
+      if (ftruncate(fd, bytes) != 0) {
+        close(fd);
+        throw runtime_error();
+      }
+    }
+    // the mapping is sized file_size(cap) from here on, it must fit exactly
+    if (bytes < file_size(0) || (bytes - OFFSET) % sizeof(T) != 0) {
+      close(fd);
+      throw runtime_error();
+    }
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      throw runtime_error();
+    }
+    base = static_cast<char *>(p);
+    arr = reinterpret_cast<T *>(base + OFFSET);
+    cap = (bytes - OFFSET) / sizeof(T);
+    if (fresh) {
+      head()->magic = MAGIC;
+      head()->elem_size = sizeof(T);
+      head()->size = 0;
+    }
+    if (head()->magic != MAGIC || head()->elem_size != sizeof(T) ||
+        head()->size > cap) {
+      munmap(base, bytes);
+      close(fd);
+      throw runtime_error();
+    }
+    siz = head()->size;
+  }
+  mapped_vector(const mapped_vector &) = delete;
+  mapped_vector &operator=(const mapped_vector &) = delete;
+  /**
+   * Destructor
+   * the elements stay in the file, the kernel writes them back
+   */
+  ~mapped_vector() {
+    munmap(base, file_size(cap));
+    close(fd);
+  }
+  /**
+   * writes the dirty pages back to the file now
+   */
+  void sync() {
+    if (msync(base, file_size(cap), MS_SYNC) != 0) {
+      throw runtime_error();
+    }
+  }
+  /**
+   * assigns specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return arr[pos];
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return arr[pos];
+  }
+  T &operator[](const size_t &pos) { return at(pos); }
+  const T &operator[](const size_t &pos) const { return at(pos); }
+  /**
+   * access the first element.
+   * throw container_is_empty if size == 0
+   */
+  const T &front() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return arr[0];
+  }
+  /**
+   * access the last element.
+   * throw container_is_empty if size == 0
+   */
+  const T &back() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return arr[siz - 1];
+  }
+  /**
+   * returns an iterator to the beginning.
+   */
+  iterator begin() { return iterator(arr, arr); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(arr, arr); }
+  /**
+   * returns an iterator to the end.
+   */
+  iterator end() { return iterator(arr, arr + siz); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(arr, arr + siz); }
+  /**
+   * checks whether the container is empty
+   */
+  bool empty() const { return !siz; }
+  /**
+   * returns the number of elements
+   */
+  size_t size() const { return siz; }
+  /**
+   * returns the number of elements the file can hold without growing
+   */
+  size_t capacity() const { return cap; }
+  /**
+   * grows the file to hold at least n elements
+   */
+  void reserve(const size_t &n) {
+    if (n > cap) {
+      remap(n);
+    }
+  }
+  /**
+   * resizes to n elements, the extra ones are value-initialized (or copies of
+   * value)
+   */
+  void resize(const size_t &n) { resize(n, T()); }
+  void resize(const size_t &n, const T &value) {
+    if (n > siz) {
+      T tmp(value); // value may be in the file, which is about to move
+      reserve(n);
+      for (size_t i = siz; i < n; i++) {
+        arr[i] = tmp;
+      }
+    }
+    set_size(n);
+  }
+  /**
+   * shrinks the file to the elements it holds
+   */
+  void shrink_to_fit() {
+    if (siz < cap) {
+      remap(siz);
+    }
+  }
+  /**
+   * clears the contents, the file keeps its size
+   */
+  void clear() { set_size(0); }
+  /**
+   * inserts value before pos
+   * returns an iterator pointing to the inserted value.
+   */
+  iterator insert(iterator pos, const T &value) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) > siz) {
+      throw invalid_iterator();
+    }
+    return insert(ind, value);
+  }
+  /**
+   * inserts value at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  iterator insert(const size_t &ind, const T &value) {
+    if (ind > siz) {
+      throw index_out_of_bound();
+    }
+    T tmp(value);
+    expand();
+    memmove((void *)(arr + ind + 1), (void *)(arr + ind),
+            sizeof(T) * (siz - ind));
+    arr[ind] = tmp;
+    set_size(siz + 1);
+    return begin() + ind;
+  }
+  /**
+   * removes the element at pos.
+   * return an iterator pointing to the following element.
+   */
+  iterator erase(iterator pos) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) >= siz) {
+      throw invalid_iterator();
+    }
+    return erase(ind);
+  }
+  /**
+   * removes the element with index ind.
+   * throw index_out_of_bound if ind >= size
+   */
+  iterator erase(const size_t &ind) {
+    if (ind >= siz) {
+      throw index_out_of_bound();
+    }
+    memmove((void *)(arr + ind), (void *)(arr + ind + 1),
+            sizeof(T) * (siz - ind - 1));
+    set_size(siz - 1);
+    return begin() + ind;
+  }
+  /**
+   * adds an element to the end.
+   */
+  void push_back(const T &value) { emplace_back(value); }
+  /**
+   * constructs an element from args at the end.
+   */
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    T tmp(std::forward<Args>(args)...);
+    expand();
+    arr[siz] = tmp;
+    set_size(siz + 1);
+    return arr[siz - 1];
+  }
+  /**
+   * remove the last element from the end.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    set_size(siz - 1);
+  }
+};
+
+} // namespace sjtu
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef SJTU_MMAP_ALLOCATOR_HPP
+#define SJTU_MMAP_ALLOCATOR_HPP
+
+#include "allocator.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace sjtu {
+/**
+ * an allocator for very big vectors.
+ * each buffer reserves a range of address space up front without committing
+ * memory and commits it GRANULE bytes at a time. a vector using it grows by
+ * committing more of the range in place (expand_in_place), so its elements
+ * are only copied when the range is used up.
+ * the range is sized from the request: the first of GRANULE, GRANULE * STEP,
+ * GRANULE * STEP^2 ... that holds it, up to a limit (64 GiB by default). a
+ * buffer thus reserves at most STEP times its size, and a vector growing to
+ * the limit moves only a few times. ranges above a granule are advised to
+ * use transparent huge pages.
+ * on systems without mmap it behaves like std::allocator.
+ */
+template <typename T> class mmap_allocator {
+private:
+  static const size_t GRANULE = size_t(2) << 20; // a huge page
+  static const size_t STEP = 16; // ratio of consecutive range sizes
+
+  size_t range; // the most address space reserved for a buffer
+
+  static size_t round_up(size_t bytes) {
+    return (bytes + GRANULE - 1) / GRANULE * GRANULE;
+  }
+  /**
+   * @brief bytes reserved for a buffer of n elements
+   * it only depends on the range size n falls in, so a buffer expanded within
+   * its range still maps back to it. a buffer bigger than the limit gets
+   * exactly its own size, which is also what it keeps, since it cannot expand
+   */
+  size_t reserved(size_t n) const {
+    size_t bytes = round_up(sizeof(T) * n);
+    if (bytes >= range) {
+      return bytes;
+    }
+    size_t r = GRANULE;
+    while (r < bytes) {
+      r *= STEP;
+    }
+    return r < range ? r : range;
+  }
+
+public:
+  using value_type = T;
+  template <typename U> struct rebind {
+    using other = mmap_allocator<U>;
+  };
+
+  explicit mmap_allocator(size_t range = size_t(64) << 30)
+      : range(round_up(range)) {}
+  template <typename U>
+  mmap_allocator(const mmap_allocator<U> &other) : range(other.reserve()) {}
+
+  /**
+   * the most bytes of address space reserved for a buffer
+   */
+  size_t reserve() const { return range; }
+
+  allocation_result<T *> allocate_at_least(size_t n) {
+#ifdef __linux__
+    size_t bytes = reserved(n);
+    // over-reserve by a granule to align the range to a huge page
+    char *raw = static_cast<char *>(
+        mmap(nullptr, bytes + GRANULE, PROT_NONE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    uintptr_t x = reinterpret_cast<uintptr_t>(raw);
+    char *p = raw + (GRANULE - x % GRANULE) % GRANULE;
+    if (p != raw) {
+      munmap(raw, p - raw);
+    }
+    munmap(p + bytes, raw + GRANULE - p);
+#ifdef MADV_HUGEPAGE
+    if (bytes > GRANULE) {
+      // only a hint, THP may be disabled. a buffer within one granule is not
+      // advised, a huge page would commit all of it at the first write
+      madvise(p, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    size_t commit = round_up(sizeof(T) * n);
+    if (commit != 0 && mprotect(p, commit, PROT_READ | PROT_WRITE) != 0) {
+      munmap(p, bytes);
+      throw std::bad_alloc();
+    }
+    return {reinterpret_cast<T *>(p), commit / sizeof(T)};
+#else
+    return {std::allocator<T>().allocate(n), n};
+#endif
+  }
+  T *allocate(size_t n) { return allocate_at_least(n).ptr; }
+  void deallocate(T *p, size_t n) {
+#ifdef __linux__
+    munmap(p, reserved(n));
+#else
+    std::allocator<T>().deallocate(p, n);
+#endif
+  }
+  /**
+   * commits more of the range reserved for p, returns false if newn does not
+   * fit in it
+   */
+  bool expand_in_place(T *p, size_t n, size_t newn) {
+#ifdef __linux__
+    size_t commit = round_up(sizeof(T) * n);
+    size_t newcommit = round_up(sizeof(T) * newn);
+    if (newcommit > reserved(n)) {
+      return false;
+    }
+    char *base = reinterpret_cast<char *>(p);
+    return newcommit == commit ||
+           mprotect(base + commit, newcommit - commit,
+                    PROT_READ | PROT_WRITE) == 0;
+#else
+    return false;
+#endif
+  }
+
+  template <typename U> bool operator==(const mmap_allocator<U> &rhs) const {
+    return range == rhs.reserve();
+  }
+  template <typename U> bool operator!=(const mmap_allocator<U> &rhs) const {
+    return range != rhs.reserve();
+  }
+};
+
+/**
+ * a vector whose storage is an mmap_allocator range
+ */
+template <typename T, typename Access = checked>
+using huge_vector = vector<T, mmap_allocator<T>, Access>;
+
+} // namespace sjtu
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sjtu {
+/**
+ * ranges of fewer bytes than this are processed on the calling thread,
+ * waking the workers costs more than it saves
+ */
+const size_t PARALLEL_THRESHOLD = size_t(4) << 20;
+/**
+ * the least number of bytes a worker is given at once
+ */
+const size_t PARALLEL_CHUNK = size_t(1) << 20;
+
+/**
+ * a fixed set of threads, one per core besides the caller, that sleep until
+ * run() hands them a job.
+ * the pool is created on first use and never destroyed, so vectors with
+ * static storage can still use it while the program exits.
+ * one job runs at a time. a run() that finds the pool busy, say a copy of a
+ * vector of vectors started from inside a worker, does its job itself.
+ */
+class worker_pool {
+private:
+  std::vector<std::thread> threads;
+  std::mutex busy;                 // held by the caller of the running job
+  std::mutex m;                    // guards the fields below
+  std::condition_variable wake;    // a new job was posted
+  std::condition_variable done;    // the last worker left the job
+  size_t generation;               // number of jobs posted
+  size_t active;                   // workers still in the current job
+  size_t tasks;                    // tasks of the current job
+  void (*fn)(void *, size_t);      // runs one task
+  void *ctx;                       // the argument of fn
+  std::atomic<size_t> next;        // the next task to hand out
+
+  worker_pool() : generation(0), active(0), tasks(0), fn(nullptr) {
+    size_t n = std::thread::hardware_concurrency();
+    for (size_t i = 1; i < n; i++) {
+      threads.emplace_back([this] { loop(); });
+    }
+  }
+
+  void work() {
+    for (size_t i; (i = next.fetch_add(1)) < tasks;) {
+      fn(ctx, i);
+    }
+  }
+
+  void loop() {
+    std::unique_lock<std::mutex> lk(m);
+    size_t seen = 0;
+    for (;;) {
+      wake.wait(lk, [&] { return generation != seen; });
+      seen = generation;
+      lk.unlock();
+      work();
+      lk.lock();
+      if (--active == 0) {
+        done.notify_one();
+      }
+    }
+  }
+
+public:
+  worker_pool(const worker_pool &) = delete;
+  worker_pool &operator=(const worker_pool &) = delete;
+
+  static worker_pool &instance() {
+    static worker_pool *pool = new worker_pool();
+    return *pool;
+  }
+
+  /**
+   * returns the number of threads a job may run on, the caller included
+   */
+  size_t size() const { return threads.size() + 1; }
+
+  /**
+   * calls f(i) for every i in [0, n) and returns when all calls are done.
+   * the calls are spread over the workers and the caller, f must not throw.
+   */
+  template <typename F> void run(size_t n, F &f) {
+    if (n <= 1 || threads.empty() || !busy.try_lock()) {
+      for (size_t i = 0; i < n; i++) {
+        f(i);
+      }
+      return;
+    }
+    std::lock_guard<std::mutex> guard(busy, std::adopt_lock);
+    {
+      std::lock_guard<std::mutex> lk(m);
+      fn = [](void *c, size_t i) { (*static_cast<F *>(c))(i); };
+      ctx = &f;
+      tasks = n;
+      next.store(0);
+      active = threads.size();
+      generation++;
+    }
+    wake.notify_all();
+    work();
+    std::unique_lock<std::mutex> lk(m);
+    done.wait(lk, [&] { return active == 0; });
+  }
+};
+
+/**
+ * calls f(lo, hi) on consecutive ranges covering [0, n), where an element
+ * takes elem_size bytes. small inputs get a single call on this thread,
+ * large ones are cut into chunks of at least PARALLEL_CHUNK bytes for the
+ * worker pool. f must not throw.
+ */
+template <typename F> void parallel_for(size_t n, size_t elem_size, F f) {
+  size_t bytes = n * elem_size;
+  if (bytes < PARALLEL_THRESHOLD) {
+    f(size_t(0), n);
+    return;
+  }
+  worker_pool &pool = worker_pool::instance();
+  size_t chunks = std::min(pool.size() * 4, bytes / PARALLEL_CHUNK);
+  // chunk k starts at bound(k), the first n % chunks chunks get one extra
+  auto bound = [&](size_t k) {
+    return n / chunks * k + std::min(k, n % chunks);
+  };
+  auto task = [&](size_t k) { f(bound(k), bound(k + 1)); };
+  pool.run(chunks, task);
+}
+
+} // namespace sjtu
+
+#endif
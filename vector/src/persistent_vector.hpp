@@ -0,0 +1,586 @@
+#ifndef SJTU_PERSISTENT_VECTOR_HPP
+#define SJTU_PERSISTENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+
+namespace sjtu {
+/**
+ * an immutable vector kept as a relaxed radix balanced (RRB) tree.
+ * every operation that changes something returns a new version and leaves
+ * the old one intact. the versions share all nodes that the change did not
+ * touch, so a new version costs O(log32 n) time and memory, not O(n).
+ *
+ * leaves hold up to 32 elements and inner nodes up to 32 children. every
+ * inner node keeps the running sizes of its children. a tree built only
+ * by push_back is perfectly regular, so a lookup takes child i >> 5h at
+ * height h. a concatenation may leave nodes that are not full; the
+ * running sizes then correct the first guess by a step or two.
+ * concat rebalances the nodes along the seam so that this stays true.
+ *
+ * at, set, push_back and concat are O(log32 n). nodes are reference
+ * counted with atomics, so versions may be shared between threads.
+ */
+template <typename T> class persistent_vector {
+private:
+  static constexpr size_t BITS = 5;
+  static constexpr size_t WIDTH = size_t(1) << BITS;
+  static constexpr size_t EXTRA = 2; // nodes a level may have above optimum
+
+  struct node {
+    std::atomic<size_t> refs;
+    size_t total; // number of elements below
+    size_t count; // elements of a leaf, children of an inner node
+
+    node() : refs(1), total(0), count(0) {}
+  };
+  struct leaf : node {
+    alignas(T) unsigned char buf[WIDTH * sizeof(T)];
+
+    T *elems() { return reinterpret_cast<T *>(buf); }
+  };
+  struct inner : node {
+    node *child[WIDTH];
+    size_t sizes[WIDTH]; // sizes[i] = elements below child[0..i]
+  };
+
+  node *root;    // nullptr when empty
+  size_t height; // height of root, a leaf has height 0
+
+  static leaf *as_leaf(node *p) { return static_cast<leaf *>(p); }
+  static inner *as_inner(node *p) { return static_cast<inner *>(p); }
+
+  static node *retain(node *p) {
+    p->refs.fetch_add(1, std::memory_order_relaxed);
+    return p;
+  }
+
+  static void release(node *p, size_t h) {
+    if (p == nullptr || p->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    if (h == 0) {
+      leaf *l = as_leaf(p);
+      for (size_t i = 0; i < l->count; i++) {
+        l->elems()[i].~T();
+      }
+      delete l;
+    } else {
+      inner *q = as_inner(p);
+      for (size_t i = 0; i < q->count; i++) {
+        release(q->child[i], h - 1);
+      }
+      delete q;
+    }
+  }
+
+  /**
+   * @brief copy n elements from src to the end of leaf l, on a throw l is
+   * released and the exception passed on
+   */
+  static void append(leaf *l, const T *src, size_t n) {
+    try {
+      for (size_t i = 0; i < n; i++) {
+        ::new (l->elems() + l->count) T(src[i]);
+        l->count++;
+        l->total++;
+      }
+    } catch (...) {
+      release(l, 0);
+      throw;
+    }
+  }
+
+  static leaf *copy_leaf(node *p) {
+    leaf *l = new leaf();
+    append(l, as_leaf(p)->elems(), p->count);
+    return l;
+  }
+
+  /**
+   * @brief an inner node over the n nodes in c, whose references it takes
+   * over
+   */
+  static inner *make_inner(node *const *c, size_t n) {
+    inner *q = new inner();
+    for (size_t i = 0; i < n; i++) {
+      q->child[i] = c[i];
+      q->total += c[i]->total;
+      q->sizes[i] = q->total;
+    }
+    q->count = n;
+    return q;
+  }
+
+  /**
+   * @brief a copy of q sharing its children
+   */
+  static inner *clone_inner(inner *q) {
+    inner *r = new inner();
+    for (size_t i = 0; i < q->count; i++) {
+      r->child[i] = retain(q->child[i]);
+      r->sizes[i] = q->sizes[i];
+    }
+    r->count = q->count;
+    r->total = q->total;
+    return r;
+  }
+
+  /**
+   * @brief the child of q (at height h) holding element i, i is made
+   * relative to that child.
+   * a child holds at most 2^(5h) elements, so i >> 5h is never past the
+   * right child and only a relaxed node needs the scan
+   */
+  static size_t slot(inner *q, size_t h, size_t &i) {
+    size_t k = i >> (BITS * h);
+    while (q->sizes[k] <= i) {
+      k++;
+    }
+    if (k > 0) {
+      i -= q->sizes[k - 1];
+    }
+    return k;
+  }
+
+  /**
+   * @brief a chain of h inner nodes down to a leaf holding x
+   */
+  static node *new_path(size_t h, const T &x) {
+    leaf *l = new leaf();
+    append(l, &x, 1);
+    node *p = l;
+    for (size_t k = 0; k < h; k++) {
+      p = make_inner(&p, 1);
+    }
+    return p;
+  }
+
+  static node *assoc(node *p, size_t h, size_t i, const T &x) {
+    if (h == 0) {
+      leaf *l = copy_leaf(p);
+      try {
+        l->elems()[i] = x;
+      } catch (...) {
+        release(l, 0);
+        throw;
+      }
+      return l;
+    }
+    inner *q = as_inner(p);
+    size_t k = slot(q, h, i);
+    node *c = assoc(q->child[k], h - 1, i, x);
+    inner *r = clone_inner(q);
+    release(r->child[k], h - 1);
+    r->child[k] = c;
+    return r;
+  }
+
+  /**
+   * @brief p (at height h) with x appended, or nullptr if p is full
+   */
+  static node *push(node *p, size_t h, const T &x) {
+    if (h == 0) {
+      if (p->count == WIDTH) {
+        return nullptr;
+      }
+      leaf *l = copy_leaf(p);
+      append(l, &x, 1);
+      return l;
+    }
+    inner *q = as_inner(p);
+    size_t last = q->count - 1;
+    node *c = push(q->child[last], h - 1, x);
+    if (c != nullptr) {
+      inner *r = clone_inner(q);
+      release(r->child[last], h - 1);
+      r->child[last] = c;
+      r->sizes[last]++;
+      r->total++;
+      return r;
+    }
+    if (q->count == WIDTH) {
+      return nullptr;
+    }
+    node *c2[WIDTH];
+    for (size_t i = 0; i < q->count; i++) {
+      c2[i] = retain(q->child[i]);
+    }
+    c2[q->count] = new_path(h - 1, x);
+    return make_inner(c2, q->count + 1);
+  }
+
+  /**
+   * @brief the number of nodes each of the n nodes in all should hold so
+   * that a lookup needs at most EXTRA steps of scanning. a node below
+   * WIDTH - EXTRA / 2 items is dissolved into the ones after it, until the
+   * count is at most the optimum plus EXTRA. returns the new count.
+   */
+  static size_t plan(size_t *sizes, size_t n) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+      total += sizes[i];
+    }
+    size_t opt = (total + WIDTH - 1) / WIDTH, i = 0;
+    while (n > opt + EXTRA) {
+      while (sizes[i] >= WIDTH - EXTRA / 2) {
+        i++;
+      }
+      size_t r = sizes[i];
+      while (r > 0) {
+        size_t s = std::min(r + sizes[i + 1], WIDTH);
+        sizes[i] = s;
+        r = r + sizes[i + 1] - s;
+        i++;
+      }
+      for (size_t j = i; j + 1 < n; j++) {
+        sizes[j] = sizes[j + 1];
+      }
+      i--;
+      n--;
+    }
+    return n;
+  }
+
+  /**
+   * @brief refill the nodes of height h in all as m nodes with the item
+   * counts in sizes, written to out. a node that already has the planned
+   * count at the right place is shared rather than copied.
+   */
+  static void execute(node *const *all, const size_t *sizes, size_t m,
+                      size_t h, node **out) {
+    size_t idx = 0, off = 0, j = 0;
+    try {
+      for (; j < m; j++) {
+        if (off == 0 && all[idx]->count == sizes[j]) {
+          out[j] = retain(all[idx++]);
+          continue;
+        }
+        if (h == 0) {
+          leaf *l = new leaf();
+          while (l->count < sizes[j]) {
+            size_t take =
+                std::min(sizes[j] - l->count, all[idx]->count - off);
+            append(l, as_leaf(all[idx])->elems() + off, take);
+            off += take;
+            if (off == all[idx]->count) {
+              idx++;
+              off = 0;
+            }
+          }
+          out[j] = l;
+        } else {
+          node *c[WIDTH];
+          for (size_t filled = 0; filled < sizes[j]; filled++) {
+            c[filled] = retain(as_inner(all[idx])->child[off]);
+            if (++off == all[idx]->count) {
+              idx++;
+              off = 0;
+            }
+          }
+          out[j] = make_inner(c, sizes[j]);
+        }
+      }
+    } catch (...) {
+      for (size_t k = 0; k < j; k++) {
+        release(out[k], h);
+      }
+      throw;
+    }
+  }
+
+  /**
+   * @brief merge the inner nodes l, c and r of height h, where c holds the
+   * merged seam of l and r and l, r may be nullptr. the last child of l and
+   * the first of r are already in c. returns a node of height h + 1 with
+   * one or two children. takes over the reference to c.
+   */
+  static inner *rebalance(inner *l, inner *c, inner *r, size_t h) {
+    node *all[3 * WIDTH];
+    size_t n = 0;
+    if (l != nullptr) {
+      for (size_t i = 0; i + 1 < l->count; i++) {
+        all[n++] = l->child[i];
+      }
+    }
+    for (size_t i = 0; i < c->count; i++) {
+      all[n++] = c->child[i];
+    }
+    if (r != nullptr) {
+      for (size_t i = 1; i < r->count; i++) {
+        all[n++] = r->child[i];
+      }
+    }
+    size_t sizes[3 * WIDTH];
+    for (size_t i = 0; i < n; i++) {
+      sizes[i] = all[i]->count;
+    }
+    size_t m = plan(sizes, n);
+    node *out[3 * WIDTH];
+    try {
+      execute(all, sizes, m, h - 1, out);
+    } catch (...) {
+      release(c, h);
+      throw;
+    }
+    release(c, h);
+    node *top[2];
+    size_t k = 0;
+    for (size_t i = 0; i < m; i += WIDTH) {
+      top[k++] = make_inner(out + i, std::min(WIDTH, m - i));
+    }
+    return make_inner(top, k);
+  }
+
+  /**
+   * @brief the concatenation of l (height hl) and r (height hr) as a node of
+   * height max(hl, hr) + 1 with one or two children
+   */
+  static inner *concat(node *l, size_t hl, node *r, size_t hr) {
+    if (hl > hr) {
+      inner *q = as_inner(l);
+      inner *c = concat(q->child[q->count - 1], hl - 1, r, hr);
+      return rebalance(q, c, nullptr, hl);
+    }
+    if (hl < hr) {
+      inner *q = as_inner(r);
+      inner *c = concat(l, hl, q->child[0], hr - 1);
+      return rebalance(nullptr, c, q, hr);
+    }
+    if (hl == 0) {
+      if (l->count + r->count <= WIDTH) {
+        node *merged = copy_leaf(l);
+        append(as_leaf(merged), as_leaf(r)->elems(), r->count);
+        return make_inner(&merged, 1);
+      }
+      node *c[2] = {retain(l), retain(r)};
+      return make_inner(c, 2);
+    }
+    inner *ql = as_inner(l), *qr = as_inner(r);
+    inner *c = concat(ql->child[ql->count - 1], hl - 1, qr->child[0], hr - 1);
+    return rebalance(ql, c, qr, hl);
+  }
+
+  persistent_vector(node *p, size_t h) : root(p), height(h) {}
+
+public:
+  class const_iterator {
+    friend class persistent_vector;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = const T *;
+    using reference = const T &;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    const persistent_vector *owner;
+    size_t pos;
+
+    const_iterator(const persistent_vector *o, size_t p) : owner(o), pos(p) {}
+
+  public:
+    const_iterator() : owner(nullptr), pos(0) {}
+
+    const_iterator operator+(difference_type n) const {
+      return const_iterator(owner, pos + n);
+    }
+    friend const_iterator operator+(difference_type n,
+                                    const const_iterator &it) {
+      return it + n;
+    }
+    const_iterator operator-(difference_type n) const {
+      return const_iterator(owner, pos - n);
+    }
+    // return the distance between two iterators,
+    // if these two iterators point to different vectors, throw
+    // invaild_iterator.
+    difference_type operator-(const const_iterator &rhs) const {
+      if (owner != rhs.owner) {
+        throw invalid_iterator();
+      }
+      return difference_type(pos - rhs.pos);
+    }
+    const_iterator &operator+=(difference_type n) {
+      pos += n;
+      return *this;
+    }
+    const_iterator &operator-=(difference_type n) {
+      pos -= n;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      pos++;
+      return tmp;
+    }
+    const_iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp = *this;
+      pos--;
+      return tmp;
+    }
+    const_iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    const T &operator*() const { return owner->lookup(pos); }
+    const T *operator->() const { return &owner->lookup(pos); }
+    const T &operator[](difference_type n) const {
+      return owner->lookup(pos + n);
+    }
+    bool operator==(const const_iterator &rhs) const {
+      return owner == rhs.owner && pos == rhs.pos;
+    }
+    bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const const_iterator &rhs) const { return pos < rhs.pos; }
+    bool operator>(const const_iterator &rhs) const { return pos > rhs.pos; }
+    bool operator<=(const const_iterator &rhs) const { return pos <= rhs.pos; }
+    bool operator>=(const const_iterator &rhs) const { return pos >= rhs.pos; }
+  };
+  using iterator = const_iterator;
+
+  persistent_vector() : root(nullptr), height(0) {}
+  /**
+   * shares every node of other, O(1)
+   */
+  persistent_vector(const persistent_vector &other)
+      : root(other.root ? retain(other.root) : nullptr), height(other.height) {
+  }
+  /**
+   * Destructor
+   */
+  ~persistent_vector() { release(root, height); }
+  /**
+   * Assignment operator, O(1)
+   */
+  persistent_vector &operator=(const persistent_vector &other) {
+    if (root != other.root) {
+      node *p = other.root ? retain(other.root) : nullptr;
+      release(root, height);
+      root = p;
+    }
+    height = other.height;
+    return *this;
+  }
+  size_t size() const { return root ? root->total : 0; }
+  bool empty() const { return !root; }
+  /**
+   * returns the height of the tree, a single leaf has height 0
+   */
+  size_t depth() const { return height; }
+  /**
+   * the element at pos, without bounds checking
+   */
+  const T &lookup(size_t pos) const {
+    node *p = root;
+    for (size_t h = height; h > 0; h--) {
+      inner *q = as_inner(p);
+      p = q->child[slot(q, h, pos)];
+    }
+    return as_leaf(p)->elems()[pos];
+  }
+  /**
+   * the element at pos.
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  const T &at(const size_t &pos) const {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return lookup(pos);
+  }
+  const T &operator[](const size_t &pos) const { return at(pos); }
+  /**
+   * access the first element.
+   * throw container_is_empty if size == 0
+   */
+  const T &front() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return lookup(0);
+  }
+  /**
+   * access the last element.
+   * throw container_is_empty if size == 0
+   */
+  const T &back() const {
+    if (empty()) {
+      throw container_is_empty();
+    }
+    return lookup(size() - 1);
+  }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(this, size()); }
+  /**
+   * returns a version with element pos replaced by value.
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  [[nodiscard]] persistent_vector set(const size_t &pos,
+                                      const T &value) const {
+    if (pos >= size()) {
+      throw index_out_of_bound();
+    }
+    return persistent_vector(assoc(root, height, pos, value), height);
+  }
+  /**
+   * returns a version with value appended.
+   */
+  [[nodiscard]] persistent_vector push_back(const T &value) const {
+    if (root == nullptr) {
+      return persistent_vector(new_path(0, value), 0);
+    }
+    node *p = push(root, height, value);
+    if (p != nullptr) {
+      return persistent_vector(p, height);
+    }
+    node *c[2] = {retain(root), nullptr};
+    try {
+      c[1] = new_path(height, value);
+    } catch (...) {
+      release(c[0], height);
+      throw;
+    }
+    return persistent_vector(make_inner(c, 2), height + 1);
+  }
+  /**
+   * returns the elements of this version followed by those of other.
+   * only the nodes along the seam are rebuilt, the rest is shared.
+   */
+  [[nodiscard]] persistent_vector concat(const persistent_vector &other) const {
+    if (other.empty()) {
+      return *this;
+    }
+    if (empty()) {
+      return other;
+    }
+    size_t h = std::max(height, other.height);
+    inner *top = concat(root, height, other.root, other.height);
+    if (top->count > 1) {
+      return persistent_vector(top, h + 1);
+    }
+    node *p = retain(top->child[0]);
+    release(top, h + 1);
+    return persistent_vector(p, h);
+  }
+  persistent_vector operator+(const persistent_vector &other) const {
+    return concat(other);
+  }
+};
+
+} // namespace sjtu
+
+#endif
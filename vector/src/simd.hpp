@@ -0,0 +1,446 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SJTU_SIMD_DISPATCH
+#define SJTU_SIMD_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace sjtu {
+/**
+ * the element types the kernels below are written for
+ */
+template <typename T>
+struct is_simd_type
+    : std::integral_constant<bool, std::is_same<T, int>::value ||
+                                       std::is_same<T, long long>::value ||
+                                       std::is_same<T, float>::value ||
+                                       std::is_same<T, double>::value> {};
+
+/**
+ * the type sum() adds in, int is widened so that a long column cannot
+ * overflow
+ */
+template <typename T>
+using sum_type = std::conditional_t<std::is_same<T, int>::value, long long, T>;
+
+/**
+ * the value and the index of the first smallest (or largest) element
+ */
+template <typename T> struct extremum {
+  T value;
+  size_t index;
+};
+
+namespace simd {
+/**
+ * plain loops, for compilers without vector extensions and for the elements
+ * after the last full vector
+ */
+namespace scalar {
+template <typename T> size_t find(const T *p, size_t n, T x) {
+  for (size_t i = 0; i < n; i++) {
+    if (p[i] == x) {
+      return i;
+    }
+  }
+  return n;
+}
+
+template <typename T> size_t count(const T *p, size_t n, T x) {
+  size_t r = 0;
+  for (size_t i = 0; i < n; i++) {
+    r += p[i] == x;
+  }
+  return r;
+}
+
+template <typename T> sum_type<T> sum(const T *p, size_t n) {
+  sum_type<T> r = 0;
+  for (size_t i = 0; i < n; i++) {
+    r += p[i];
+  }
+  return r;
+}
+
+/**
+ * @brief the index of the first smallest (largest if Max) element, n > 0
+ */
+template <bool Max, typename T> size_t extreme(const T *p, size_t n) {
+  size_t r = 0;
+  for (size_t i = 1; i < n; i++) {
+    if (Max ? p[r] < p[i] : p[i] < p[r]) {
+      r = i;
+    }
+  }
+  return r;
+}
+
+template <typename T> void fill(T *p, size_t n, T x) {
+  for (size_t i = 0; i < n; i++) {
+    p[i] = x;
+  }
+}
+} // namespace scalar
+
+#if defined(__GNUC__)
+/**
+ * the kernels, written once with the vector extensions of GCC and Clang for
+ * vectors of W bytes. they hold no intrinsics, so once inlined into a
+ * function compiled for AVX2 they become AVX2 code, and SSE2 (or NEON)
+ * code elsewhere. loads and stores go through memcpy, the data need not be
+ * aligned.
+ */
+namespace kernel {
+#define SJTU_SIMD_INLINE __attribute__((always_inline)) inline
+
+template <typename T, size_t W> struct vec {
+  typedef T type __attribute__((vector_size(W)));
+};
+
+/**
+ * @brief set every lane of v to x
+ * vectors are passed by reference, by value they would change the ABI
+ * between the AVX2 and the base code
+ */
+template <typename V, typename T> SJTU_SIMD_INLINE void splat(V &v, T x) {
+  for (size_t j = 0; j < sizeof(V) / sizeof(T); j++) {
+    v[j] = x;
+  }
+}
+
+/**
+ * @brief whether any lane of the comparison result m is set
+ */
+template <typename M> SJTU_SIMD_INLINE bool any(const M &m) {
+  unsigned long long w[sizeof(M) / 8];
+  memcpy(w, &m, sizeof(M));
+  unsigned long long r = 0;
+  for (size_t j = 0; j < sizeof(M) / 8; j++) {
+    r |= w[j];
+  }
+  return r != 0;
+}
+
+/**
+ * four vectors are compared before testing the result, a hit is then
+ * located by the scalar loop
+ */
+template <size_t W, typename T>
+SJTU_SIMD_INLINE size_t find(const T *p, size_t n, T x) {
+  using V = typename vec<T, W>::type;
+  const size_t L = W / sizeof(T);
+  V k, a, b, c, d;
+  splat(k, x);
+  size_t i = 0;
+  for (; i + 4 * L <= n; i += 4 * L) {
+    memcpy(&a, p + i, W);
+    memcpy(&b, p + i + L, W);
+    memcpy(&c, p + i + 2 * L, W);
+    memcpy(&d, p + i + 3 * L, W);
+    if (any((a == k) | (b == k) | (c == k) | (d == k))) {
+      break;
+    }
+  }
+  return i + scalar::find(p + i, n - i, x);
+}
+
+/**
+ * a matching lane compares to -1, so subtracting the comparisons counts
+ * them per lane. the lanes are flushed every BLOCK elements before they
+ * could overflow.
+ */
+template <size_t W, typename T>
+SJTU_SIMD_INLINE size_t count(const T *p, size_t n, T x) {
+  using V = typename vec<T, W>::type;
+  using M = decltype(V() == V());
+  const size_t L = W / sizeof(T), BLOCK = L << 24;
+  V k, a, b;
+  splat(k, x);
+  size_t r = 0, i = 0;
+  while (i + 2 * L <= n) {
+    M acc = {};
+    size_t end = n - i < BLOCK ? n : i + BLOCK;
+    for (; i + 2 * L <= end; i += 2 * L) {
+      memcpy(&a, p + i, W);
+      memcpy(&b, p + i + L, W);
+      acc -= a == k;
+      acc -= b == k;
+    }
+    for (size_t j = 0; j < L; j++) {
+      r += acc[j];
+    }
+  }
+  return r + scalar::count(p + i, n - i, x);
+}
+
+/**
+ * two accumulators hide the latency of the additions. elements are
+ * converted to sum_type<T> on the way, so W bytes of sums take fewer than
+ * W bytes of elements when int is widened.
+ */
+template <size_t W, typename T>
+SJTU_SIMD_INLINE sum_type<T> sum(const T *p, size_t n) {
+  using A = sum_type<T>;
+  const size_t L = W / sizeof(A);
+  using S = typename vec<A, W>::type;
+  using V = typename vec<T, L * sizeof(T)>::type;
+  S s0 = {}, s1 = {};
+  V a, b;
+  size_t i = 0;
+  for (; i + 2 * L <= n; i += 2 * L) {
+    memcpy(&a, p + i, sizeof(V));
+    memcpy(&b, p + i + L, sizeof(V));
+    s0 += __builtin_convertvector(a, S);
+    s1 += __builtin_convertvector(b, S);
+  }
+  s0 += s1;
+  A r = 0;
+  for (size_t j = 0; j < L; j++) {
+    r += s0[j];
+  }
+  return r + scalar::sum(p + i, n - i);
+}
+
+/**
+ * the lane-wise extreme of each block of BLOCK elements is reduced to a
+ * value, and the first block with the best value is remembered. only that
+ * block is scanned again for the index, it is still in cache. the scan is a
+ * reduction rather than a search for the value, which a NaN would never
+ * match, so the index stays in range whatever the data.
+ */
+template <bool Max, size_t W, typename T>
+SJTU_SIMD_INLINE size_t extreme(const T *p, size_t n) {
+  using V = typename vec<T, W>::type;
+  const size_t L = W / sizeof(T), BLOCK = 1024;
+  auto better = [](T a, T b) { return Max ? b < a : a < b; };
+  T best = p[0];
+  size_t from = 0, i = 0;
+  V m, v;
+  for (; i + BLOCK <= n; i += BLOCK) {
+    memcpy(&m, p + i, W);
+    for (size_t j = i + L; j < i + BLOCK; j += L) {
+      memcpy(&v, p + j, W);
+      if constexpr (Max) {
+        m = m < v ? v : m;
+      } else {
+        m = v < m ? v : m;
+      }
+    }
+    T b = m[0];
+    for (size_t j = 1; j < L; j++) {
+      b = better(m[j], b) ? m[j] : b;
+    }
+    if (better(b, best)) {
+      best = b;
+      from = i;
+    }
+  }
+  if (i < n) {
+    size_t t = i + scalar::extreme<Max>(p + i, n - i);
+    if (better(p[t], best)) {
+      return t;
+    }
+  }
+  size_t len = n - from < BLOCK ? n - from : BLOCK;
+  return from + scalar::extreme<Max>(p + from, len);
+}
+
+template <size_t W, typename T>
+SJTU_SIMD_INLINE void fill(T *p, size_t n, T x) {
+  using V = typename vec<T, W>::type;
+  const size_t L = W / sizeof(T);
+  V k;
+  splat(k, x);
+  size_t i = 0;
+  for (; i + L <= n; i += L) {
+    memcpy(p + i, &k, W);
+  }
+  scalar::fill(p + i, n - i, x);
+}
+
+#undef SJTU_SIMD_INLINE
+} // namespace kernel
+#endif
+
+#if defined(SJTU_SIMD_DISPATCH)
+/**
+ * the kernels on 32-byte vectors, only called if the cpu has AVX2
+ */
+namespace avx2 {
+template <typename T> SJTU_SIMD_AVX2 size_t find(const T *p, size_t n, T x) {
+  return kernel::find<32>(p, n, x);
+}
+template <typename T> SJTU_SIMD_AVX2 size_t count(const T *p, size_t n, T x) {
+  return kernel::count<32>(p, n, x);
+}
+template <typename T> SJTU_SIMD_AVX2 sum_type<T> sum(const T *p, size_t n) {
+  return kernel::sum<32>(p, n);
+}
+template <bool Max, typename T>
+SJTU_SIMD_AVX2 size_t extreme(const T *p, size_t n) {
+  return kernel::extreme<Max, 32>(p, n);
+}
+template <typename T> SJTU_SIMD_AVX2 void fill(T *p, size_t n, T x) {
+  kernel::fill<32>(p, n, x);
+}
+} // namespace avx2
+
+inline bool has_avx2() {
+  static const bool yes = __builtin_cpu_supports("avx2");
+  return yes;
+}
+#endif
+
+#if defined(__GNUC__)
+/**
+ * the kernels on 16-byte vectors, SSE2 on x86 and NEON on ARM
+ */
+namespace base {
+template <typename T> size_t find(const T *p, size_t n, T x) {
+  return kernel::find<16>(p, n, x);
+}
+template <typename T> size_t count(const T *p, size_t n, T x) {
+  return kernel::count<16>(p, n, x);
+}
+template <typename T> sum_type<T> sum(const T *p, size_t n) {
+  return kernel::sum<16>(p, n);
+}
+template <bool Max, typename T> size_t extreme(const T *p, size_t n) {
+  return kernel::extreme<Max, 16>(p, n);
+}
+template <typename T> void fill(T *p, size_t n, T x) {
+  kernel::fill<16>(p, n, x);
+}
+} // namespace base
+#else
+namespace base = scalar;
+#endif
+
+/**
+ * the entry points, AVX2 if the cpu has it and the base kernels otherwise
+ */
+template <typename T> size_t find(const T *p, size_t n, T x) {
+#if defined(SJTU_SIMD_DISPATCH)
+  if (has_avx2()) {
+    return avx2::find(p, n, x);
+  }
+#endif
+  return base::find(p, n, x);
+}
+
+template <typename T> size_t count(const T *p, size_t n, T x) {
+#if defined(SJTU_SIMD_DISPATCH)
+  if (has_avx2()) {
+    return avx2::count(p, n, x);
+  }
+#endif
+  return base::count(p, n, x);
+}
+
+template <typename T> sum_type<T> sum(const T *p, size_t n) {
+#if defined(SJTU_SIMD_DISPATCH)
+  if (has_avx2()) {
+    return avx2::sum(p, n);
+  }
+#endif
+  return base::sum(p, n);
+}
+
+template <bool Max, typename T> size_t extreme(const T *p, size_t n) {
+#if defined(SJTU_SIMD_DISPATCH)
+  if (has_avx2()) {
+    return avx2::extreme<Max>(p, n);
+  }
+#endif
+  return base::extreme<Max>(p, n);
+}
+
+template <typename T> void fill(T *p, size_t n, T x) {
+#if defined(SJTU_SIMD_DISPATCH)
+  if (has_avx2()) {
+    avx2::fill(p, n, x);
+    return;
+  }
+#endif
+  base::fill(p, n, x);
+}
+} // namespace simd
+
+/**
+ * the algorithms below take a whole vector of int, long long, float or
+ * double and work on its array directly, without the checks of operator[].
+ * floating point values are added and compared lane by lane, so a float sum
+ * may round differently from an in-order loop, and which element is the
+ * extremum of a vector holding NaN is unspecified.
+ */
+template <typename T, typename R>
+using if_simd = std::enable_if_t<is_simd_type<T>::value, R>;
+
+/**
+ * returns the index of the first element equal to x, or size() if there is
+ * none
+ */
+template <typename T, typename A, typename Acc, typename G>
+if_simd<T, size_t> find(const vector<T, A, Acc, G> &v, const T &x) {
+  return simd::find(v.data(), v.size(), x);
+}
+/**
+ * returns the number of elements equal to x
+ */
+template <typename T, typename A, typename Acc, typename G>
+if_simd<T, size_t> count(const vector<T, A, Acc, G> &v, const T &x) {
+  return simd::count(v.data(), v.size(), x);
+}
+/**
+ * returns the sum of the elements, 0 if there are none
+ */
+template <typename T, typename A, typename Acc, typename G>
+if_simd<T, sum_type<T>> sum(const vector<T, A, Acc, G> &v) {
+  return simd::sum(v.data(), v.size());
+}
+/**
+ * returns the first smallest element and its index.
+ * throw container_is_empty if size() == 0
+ */
+template <typename T, typename A, typename Acc, typename G>
+if_simd<T, extremum<T>> min_element(const vector<T, A, Acc, G> &v) {
+  if (v.empty()) {
+    throw container_is_empty();
+  }
+  size_t i = simd::extreme<false>(v.data(), v.size());
+  return extremum<T>{v.data()[i], i};
+}
+/**
+ * returns the first largest element and its index.
+ * throw container_is_empty if size() == 0
+ */
+template <typename T, typename A, typename Acc, typename G>
+if_simd<T, extremum<T>> max_element(const vector<T, A, Acc, G> &v) {
+  if (v.empty()) {
+    throw container_is_empty();
+  }
+  size_t i = simd::extreme<true>(v.data(), v.size());
+  return extremum<T>{v.data()[i], i};
+}
+/**
+ * assigns x to every element
+ */
+template <typename T, typename A, typename Acc, typename G>
+if_simd<T, void> fill(vector<T, A, Acc, G> &v, const T &x) {
+  simd::fill(v.data(), v.size(), x);
+}
+
+} // namespace sjtu
+
+#undef SJTU_SIMD_DISPATCH
+#undef SJTU_SIMD_AVX2
+
+#endif
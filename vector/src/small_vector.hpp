@@ -0,0 +1,95 @@
+#ifndef SJTU_SMALL_VECTOR_HPP
+#define SJTU_SMALL_VECTOR_HPP
+
+#include "allocator.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace sjtu {
+/**
+ * an allocator holding room for N elements inside itself.
+ * a request for at most N elements gets the inline buffer if it is free,
+ * anything else goes to std::allocator. copies start with a free buffer of
+ * their own, so two instances never share memory.
+ */
+template <typename T, size_t N> class inline_allocator {
+private:
+  alignas(T) unsigned char buf[sizeof(T) * N];
+  bool used; // whether buf is handed out
+
+  T *local() { return reinterpret_cast<T *>(buf); }
+
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+  template <typename U> struct rebind {
+    using other = inline_allocator<U, N>;
+  };
+
+  inline_allocator() : used(false) {}
+  inline_allocator(const inline_allocator &) : used(false) {}
+  inline_allocator &operator=(const inline_allocator &) { return *this; }
+
+  allocation_result<T *> allocate_at_least(size_t n) {
+    if (!used && n <= N) {
+      used = true;
+      return {local(), N};
+    }
+    return {std::allocator<T>().allocate(n), n};
+  }
+  T *allocate(size_t n) { return allocate_at_least(n).ptr; }
+  void deallocate(T *p, size_t n) {
+    if (p == local()) {
+      used = false;
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+  bool operator==(const inline_allocator &rhs) const { return this == &rhs; }
+  bool operator!=(const inline_allocator &rhs) const { return this != &rhs; }
+};
+
+/**
+ * a vector keeping up to N elements inside the object itself, spilling to
+ * the heap only when it grows past N.
+ * it has the same interface, iterators and exceptions as sjtu::vector, and
+ * going back to at most N elements with shrink_to_fit() returns to the
+ * inline buffer.
+ */
+template <typename T, size_t N, typename Access = checked,
+          typename Growth = geometric_growth<>>
+class small_vector : public vector<T, inline_allocator<T, N>, Access, Growth> {
+private:
+  using base = vector<T, inline_allocator<T, N>, Access, Growth>;
+
+public:
+  small_vector() { base::reserve(N); }
+  small_vector(const small_vector &other) : base(other) { base::reserve(N); }
+  small_vector &operator=(const small_vector &other) {
+    base::operator=(other);
+    return *this;
+  }
+  /**
+   * releases the heap storage, moving the elements back inline if they fit
+   */
+  void shrink_to_fit() {
+    if (!is_inline()) {
+      base::shrink_to_fit();
+    }
+  }
+  /**
+   * whether the elements are stored inline
+   * the heap is only used for more than N elements, so an inline buffer is
+   * exactly one with capacity at most N
+   */
+  bool is_inline() const { return base::capacity() <= N; }
+};
+
+} // namespace sjtu
+
+#endif
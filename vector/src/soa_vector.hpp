@@ -0,0 +1,315 @@
+#ifndef SJTU_SOA_VECTOR_HPP
+#define SJTU_SOA_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * the element type of the column holding a field of type T. vector<bool>
+ * packs its flags into bits and has no bool & or bool * to hand out, so a
+ * bool field is kept in a column of unsigned char holding 0 or 1.
+ */
+template <typename T> struct soa_column {
+  using type = T;
+};
+template <> struct soa_column<bool> {
+  using type = unsigned char;
+};
+template <typename T> using soa_column_t = typename soa_column<T>::type;
+
+/**
+ * a vector of records stored as a structure of arrays: field I of every row
+ * lives in column I, a contiguous array of its own. a pass reading one field
+ * then touches only that column, instead of dragging the whole record
+ * through the cache.
+ * rows are pushed, popped and read as a whole; a row is handed out as a
+ * std::tuple of references into the columns, so
+ * @code{for (auto [x, y] : v)} binds x and y to the fields of each row.
+ * column<I>() gives the raw array of a field for tight loops.
+ * a bool field is stored, referred to and handed out as unsigned char, see
+ * soa_column.
+ * the columns are unchecked vectors, the bounds are checked once per row.
+ */
+template <typename... Fields> class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+public:
+  static const size_t FIELDS = sizeof...(Fields);
+  template <size_t I>
+  using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+  template <size_t I> using column_type = soa_column_t<field_type<I>>;
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<soa_column_t<Fields> &...>;
+  using const_reference = std::tuple<const soa_column_t<Fields> &...>;
+
+private:
+  using indices = std::index_sequence_for<Fields...>;
+
+  std::tuple<vector<soa_column_t<Fields>, std::allocator<soa_column_t<Fields>>,
+                    unchecked>...>
+      cols;
+  size_t siz; // number of rows
+
+  template <size_t... I> reference row(size_t pos, std::index_sequence<I...>) {
+    return reference(std::get<I>(cols)[pos]...);
+  }
+  template <size_t... I>
+  const_reference row(size_t pos, std::index_sequence<I...>) const {
+    return const_reference(std::get<I>(cols)[pos]...);
+  }
+
+  /**
+   * @brief append one value to every column. if a constructor throws, the
+   * columns already appended to are popped again, so the row is all or
+   * nothing
+   */
+  template <size_t... I, typename... Args>
+  void append(std::index_sequence<I...>, Args &&...args) {
+    size_t done = 0;
+    try {
+      ((std::get<I>(cols).push_back(std::forward<Args>(args)), done++), ...);
+    } catch (...) {
+      ((I < done ? std::get<I>(cols).pop_back() : void()), ...);
+      throw;
+    }
+    siz++;
+  }
+
+  template <typename F, size_t... I>
+  void each(F f, std::index_sequence<I...>) {
+    (f(std::get<I>(cols)), ...);
+  }
+
+  template <bool Const> class basic_iterator {
+    friend class soa_vector;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = soa_vector::value_type;
+    using pointer = void;
+    using reference =
+        std::conditional_t<Const, soa_vector::const_reference,
+                           soa_vector::reference>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    using owner_type =
+        std::conditional_t<Const, const soa_vector *, soa_vector *>;
+    owner_type owner;
+    size_t pos;
+
+    basic_iterator(owner_type o, size_t p) : owner(o), pos(p) {}
+
+  public:
+    basic_iterator() : owner(nullptr), pos(0) {}
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &it)
+        : owner(it.owner), pos(it.pos) {}
+
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(owner, pos + n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(owner, pos - n);
+    }
+    // return the distance between two iterators,
+    // if these two iterators point to different vectors, throw
+    // invaild_iterator.
+    difference_type operator-(const basic_iterator &rhs) const {
+      if (owner != rhs.owner) {
+        throw invalid_iterator();
+      }
+      return difference_type(pos - rhs.pos);
+    }
+    basic_iterator &operator+=(difference_type n) {
+      pos += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      pos -= n;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      pos++;
+      return tmp;
+    }
+    basic_iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      pos--;
+      return tmp;
+    }
+    basic_iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    reference operator*() const { return owner->row(pos, indices()); }
+    reference operator[](difference_type n) const {
+      return owner->row(pos + n, indices());
+    }
+    bool operator==(const basic_iterator &rhs) const {
+      return owner == rhs.owner && pos == rhs.pos;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return pos < rhs.pos; }
+    bool operator>(const basic_iterator &rhs) const { return pos > rhs.pos; }
+    bool operator<=(const basic_iterator &rhs) const { return pos <= rhs.pos; }
+    bool operator>=(const basic_iterator &rhs) const { return pos >= rhs.pos; }
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  soa_vector() : siz(0) {}
+  /**
+   * the row pos as a tuple of references to its fields
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  reference at(const size_t &pos) {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return row(pos, indices());
+  }
+  const_reference at(const size_t &pos) const {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return row(pos, indices());
+  }
+  reference operator[](const size_t &pos) { return at(pos); }
+  const_reference operator[](const size_t &pos) const { return at(pos); }
+  /**
+   * field I of row pos
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  template <size_t I> column_type<I> &get(const size_t &pos) {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return std::get<I>(cols)[pos];
+  }
+  template <size_t I> const column_type<I> &get(const size_t &pos) const {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return std::get<I>(cols)[pos];
+  }
+  /**
+   * the array of field I, size() values long
+   */
+  template <size_t I> column_type<I> *column() {
+    return std::get<I>(cols).data();
+  }
+  template <size_t I> const column_type<I> *column() const {
+    return std::get<I>(cols).data();
+  }
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, siz); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(this, siz); }
+  bool empty() const { return !siz; }
+  size_t size() const { return siz; }
+  /**
+   * returns the number of rows that can be held without reallocation
+   */
+  size_t capacity() const { return std::get<0>(cols).capacity(); }
+  /**
+   * makes room for n rows in every column
+   */
+  void reserve(const size_t &n) {
+    each([&](auto &c) { c.reserve(n); }, indices());
+  }
+  /**
+   * resizes to n rows, the new fields are value-initialized
+   */
+  void resize(const size_t &n) {
+    reserve(n);
+    each([&](auto &c) { c.resize(n); }, indices());
+    siz = n;
+  }
+  /**
+   * releases the unused capacity of every column
+   */
+  void shrink_to_fit() {
+    each([](auto &c) { c.shrink_to_fit(); }, indices());
+  }
+  /**
+   * clears the contents, the capacity is kept for later insertions
+   */
+  void clear() {
+    each([](auto &c) { c.clear(); }, indices());
+    siz = 0;
+  }
+  /**
+   * adds a row to the end, one value per field
+   */
+  void push_back(const Fields &...values) { append(indices(), values...); }
+  void push_back(Fields &&...values) {
+    append(indices(), std::move(values)...);
+  }
+  /**
+   * adds a row given as a tuple, e.g. one read out of another soa_vector
+   */
+  template <typename... Ts> void push_back(const std::tuple<Ts...> &row) {
+    static_assert(sizeof...(Ts) == FIELDS, "a row needs one value per field");
+    std::apply([&](const Ts &...values) { append(indices(), values...); },
+               row);
+  }
+  /**
+   * remove the last row.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    each([](auto &c) { c.pop_back(); }, indices());
+    siz--;
+  }
+  /**
+   * removes the row with index ind.
+   * throw index_out_of_bound if ind >= size
+   */
+  void erase(const size_t &ind) {
+    if (ind >= siz) {
+      throw index_out_of_bound();
+    }
+    each([&](auto &c) { c.erase(ind); }, indices());
+    siz--;
+  }
+  /**
+   * removes the row with index ind in O(1) by moving the last row into its
+   * place, so the order of the rows is not kept.
+   * throw index_out_of_bound if ind >= size
+   */
+  void swap_remove(const size_t &ind) {
+    if (ind >= siz) {
+      throw index_out_of_bound();
+    }
+    each([&](auto &c) { c.swap_remove(ind); }, indices());
+    siz--;
+  }
+};
+
+} // namespace sjtu
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef SJTU_STABLE_VECTOR_HPP
+#define SJTU_STABLE_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+/**
+ * a vector made of blocks that never move.
+ * block k holds 2^(Shift + k) elements, so the blocks double in size and a
+ * fixed table of them covers any size. growing adds a block and relocates
+ * nothing, so pointers, references and iterators to elements stay valid
+ * until the element is removed. indexing finds the block from the position
+ * of the highest set bit, in O(1).
+ * only the back can be changed, there is no insert or erase in the middle.
+ */
+template <typename T, typename Allocator = std::allocator<T>, size_t Shift = 4>
+class stable_vector {
+private:
+  using traits = std::allocator_traits<Allocator>;
+  static const size_t BLOCKS = sizeof(size_t) * 8 - Shift;
+
+  T *blocks[BLOCKS]; // block table, nullptr for blocks not allocated yet
+  size_t siz;        // size
+  size_t nblocks;    // number of allocated blocks
+  Allocator alloc;   // allocator
+
+  static size_t block_size(size_t k) { return size_t(1) << (Shift + k); }
+
+  /**
+   * @brief the index of the highest set bit of x > 0
+   */
+  static size_t log2(size_t x) {
+#if defined(__GNUC__)
+    return sizeof(unsigned long long) * 8 - 1 -
+           __builtin_clzll((unsigned long long)x);
+#else
+    size_t r = 0;
+    while (x >>= 1) {
+      r++;
+    }
+    return r;
+#endif
+  }
+
+  /**
+   * @brief locate the element with index pos as block k, offset off
+   * element pos is number pos + 2^Shift counting from block 0 as if there
+   * were a block of size 2^Shift before it
+   */
+  static void locate(size_t pos, size_t &k, size_t &off) {
+    size_t x = pos + block_size(0);
+    k = log2(x) - Shift;
+    off = x - block_size(k);
+  }
+
+  T *slot(size_t pos) const {
+    size_t k, off;
+    locate(pos, k, off);
+    return blocks[k] + off;
+  }
+
+  /**
+   * @brief make sure there is room for element pos
+   */
+  void expand(size_t pos) {
+    size_t k, off;
+    locate(pos, k, off);
+    while (nblocks <= k) {
+      blocks[nblocks] = traits::allocate(alloc, block_size(nblocks));
+      nblocks++;
+    }
+  }
+
+  template <bool Const> class basic_iterator {
+    friend class stable_vector;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    using owner_type =
+        std::conditional_t<Const, const stable_vector *, stable_vector *>;
+    owner_type owner;
+    size_t pos;
+
+    basic_iterator(owner_type o, size_t p) : owner(o), pos(p) {}
+
+  public:
+    basic_iterator() : owner(nullptr), pos(0) {}
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &it) : owner(it.owner), pos(it.pos) {}
+
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(owner, pos + n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(owner, pos - n);
+    }
+    // return the distance between two iterators,
+    // if these two iterators point to different vectors, throw
+    // invaild_iterator.
+    difference_type operator-(const basic_iterator &rhs) const {
+      if (owner != rhs.owner) {
+        throw invalid_iterator();
+      }
+      return difference_type(pos - rhs.pos);
+    }
+    basic_iterator &operator+=(difference_type n) {
+      pos += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      pos -= n;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      pos++;
+      return tmp;
+    }
+    basic_iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      pos--;
+      return tmp;
+    }
+    basic_iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    reference operator*() const { return *owner->slot(pos); }
+    pointer operator->() const { return owner->slot(pos); }
+    reference operator[](difference_type n) const {
+      return *owner->slot(pos + n);
+    }
+    bool operator==(const basic_iterator &rhs) const {
+      return owner == rhs.owner && pos == rhs.pos;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return pos < rhs.pos; }
+    bool operator>(const basic_iterator &rhs) const { return pos > rhs.pos; }
+    bool operator<=(const basic_iterator &rhs) const { return pos <= rhs.pos; }
+    bool operator>=(const basic_iterator &rhs) const { return pos >= rhs.pos; }
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  stable_vector() : blocks(), siz(0), nblocks(0) {}
+  explicit stable_vector(const Allocator &a)
+      : blocks(), siz(0), nblocks(0), alloc(a) {}
+  stable_vector(const stable_vector &other)
+      // delegating, so a throwing copy runs the destructor on what is built
+      : stable_vector(
+            traits::select_on_container_copy_construction(other.alloc)) {
+    for (size_t i = 0; i < other.siz; i++) {
+      push_back(other[i]);
+    }
+  }
+  /**
+   * Destructor
+   */
+  ~stable_vector() { release(); }
+  /**
+   * Assignment operator
+   * the elements are assigned in place, so pointers to the first
+   * min(size(), other.size()) elements stay valid
+   */
+  stable_vector &operator=(const stable_vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    size_t i = 0;
+    for (; i < siz && i < other.siz; i++) {
+      *slot(i) = other[i];
+    }
+    while (siz > other.siz) {
+      pop_back();
+    }
+    for (; i < other.siz; i++) {
+      push_back(other[i]);
+    }
+    return *this;
+  }
+  /**
+   * assigns specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  T &at(const size_t &pos) {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return *slot(pos);
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return *slot(pos);
+  }
+  T &operator[](const size_t &pos) { return at(pos); }
+  const T &operator[](const size_t &pos) const { return at(pos); }
+  /**
+   * access the first element.
+   * throw container_is_empty if size == 0
+   */
+  const T &front() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return *slot(0);
+  }
+  /**
+   * access the last element.
+   * throw container_is_empty if size == 0
+   */
+  const T &back() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return *slot(siz - 1);
+  }
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, siz); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(this, siz); }
+  bool empty() const { return !siz; }
+  size_t size() const { return siz; }
+  /**
+   * returns the number of elements the allocated blocks hold
+   */
+  size_t capacity() const { return block_size(nblocks) - block_size(0); }
+  /**
+   * allocates the blocks for the first n elements
+   */
+  void reserve(const size_t &n) {
+    if (n > 0) {
+      expand(n - 1);
+    }
+  }
+  /**
+   * clears the contents, the blocks are kept for later insertions
+   */
+  void clear() {
+    while (siz > 0) {
+      traits::destroy(alloc, slot(--siz));
+    }
+  }
+  /**
+   * clears the contents and frees the blocks
+   */
+  void release() {
+    clear();
+    for (size_t k = 0; k < nblocks; k++) {
+      traits::deallocate(alloc, blocks[k], block_size(k));
+      blocks[k] = nullptr;
+    }
+    nblocks = 0;
+  }
+  /**
+   * adds an element to the end.
+   */
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  /**
+   * constructs an element from args at the end.
+   * no element moves, so args may refer into this vector.
+   */
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    expand(siz);
+    T *p = slot(siz);
+    traits::construct(alloc, p, std::forward<Args>(args)...);
+    siz++;
+    return *p;
+  }
+  /**
+   * remove the last element from the end.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    traits::destroy(alloc, slot(--siz));
+  }
+};
+
+} // namespace sjtu
+
+#endif
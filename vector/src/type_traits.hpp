@@ -0,0 +1,36 @@
+#ifndef SJTU_TYPE_TRAITS_HPP
+#define SJTU_TYPE_TRAITS_HPP
+
+#include <type_traits>
+
+namespace sjtu {
+/**
+ * whether an object of T can be moved to another address by copying its bytes
+ * and forgetting the source, without calling any constructor or destructor.
+ * it holds for trivially copyable types. other types that hold no pointer to
+ * themselves can opt in by specializing it, e.g.
+ * @code{template <> struct sjtu::is_trivially_relocatable<Foo>
+ *   : std::true_type {};}
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * whether the constructors, assignments and destructor of T may run on
+ * different objects on several threads at once, which lets vector spread
+ * big copies, fills and destruction over the worker pool of parallel.hpp.
+ * noexcept alone does not say so: a vector using a pool_allocator frees into
+ * an unsynchronized free list. it holds for trivially copyable types with a
+ * trivial default constructor, which only copy bytes. other types that touch
+ * no shared state can opt in by specializing it, as above.
+ */
+template <typename T>
+struct is_parallel_safe
+    : std::integral_constant<bool,
+                             std::is_trivially_copyable<T>::value &&
+                                 std::is_trivially_default_constructible<
+                                     T>::value> {};
+
+} // namespace sjtu
+
+#endif
@@ -1,43 +1,362 @@
 #ifndef SJTU_VECTOR_HPP
 #define SJTU_VECTOR_HPP
 
+#include "allocator.hpp"
 #include "exceptions.hpp"
+#include "growth.hpp"
+#include "parallel.hpp"
+#include "type_traits.hpp"
 
+#include <algorithm>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu {
+/**
+ * access policies of vector.
+ * checked: operator[] throws index_out_of_bound, and an iterator remembers its
+ * vector so that subtracting iterators of different vectors throws
+ * invalid_iterator.
+ * unchecked: operator[] is a plain load and an iterator is a bare pointer.
+ */
+struct checked {
+  static constexpr bool value = true;
+};
+struct unchecked {
+  static constexpr bool value = false;
+};
+
+/**
+ * the part of a vector iterator recording which vector it belongs to, empty
+ * for unchecked vectors
+ */
+template <typename T, bool Checked> class iterator_origin {
+protected:
+  T *beg; // the beginning of the vector
+
+  explicit iterator_origin(T *b) : beg(b) {}
+  T *origin() const { return beg; }
+  bool same_origin(const iterator_origin &rhs) const { return beg == rhs.beg; }
+};
+template <typename T> class iterator_origin<T, false> {
+protected:
+  explicit iterator_origin(T *) {}
+  T *origin() const { return nullptr; }
+  bool same_origin(const iterator_origin &) const { return true; }
+};
+
+/**
+ * how vector::save and vector::load write and read an element that is not
+ * trivially copyable. specialize it with
+ * @code{static void save(std::ostream &os, const T &x)} and
+ * @code{static T load(std::istream &is)}.
+ */
+template <typename T> struct serializer;
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * the storage is obtained from Allocator through std::allocator_traits, see
+ * allocator.hpp for arena and pool allocators.
+ * Access is checked or unchecked, see above.
+ * Growth decides the capacity to grow to and may keep statistics, see
+ * growth.hpp.
  */
-template <typename T> class vector {
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Access = checked, typename Growth = geometric_growth<>>
+class vector : private Growth {
 private:
-  T *arr;                  // array
-  size_t siz;              // size
-  size_t cap;              // capacity
-  std::allocator<T> alloc; // allocator
+  using traits = std::allocator_traits<Allocator>;
+
+  T *arr;          // array
+  size_t siz;      // size
+  size_t cap;      // capacity
+  Allocator alloc; // allocator
 
   /**
-   * @brief expand to fit more elements
+   * @brief get a buffer for at least n elements, n is updated to the number
+   * it actually holds if the allocator provides allocate_at_least
    */
-  void expand() {
-    if (siz >= cap) {
-      size_t newcap = siz * 1.5 + 3;
-      T *p = alloc.allocate(newcap);
-      // copy
-      for (size_t i = 0; i < siz; i++) {
-        alloc.construct(p + i, arr[i]);
+  T *allocate(size_t &n) {
+    if constexpr (has_allocate_at_least<Allocator>::value) {
+      auto res = alloc.allocate_at_least(n);
+      n = res.count;
+      return res.ptr;
+    } else {
+      return traits::allocate(alloc, n);
+    }
+  }
+
+  /**
+   * @brief call f(i) for every i in [0, n)
+   * if Nothrow says f cannot throw and T is_parallel_safe (type_traits.hpp),
+   * a large range is spread over the worker pool of parallel.hpp, which also
+   * spreads the first touch of fresh pages over the cores. otherwise the
+   * calls run on this thread in order, so that a throw leaves a known prefix
+   * done.
+   */
+  template <bool Nothrow, typename F> void for_each_index(size_t n, F f) {
+    if constexpr (Nothrow && is_parallel_safe<T>::value) {
+      parallel_for(n, sizeof(T), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++) {
+          f(i);
+        }
+      });
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        f(i);
       }
-      if (arr != nullptr) {
-        for (size_t i = 0; i < siz; i++) {
-          alloc.destroy(arr + i);
+    }
+  }
+
+  /**
+   * @brief construct n elements at the end by build(p), where p points to
+   * the slot of each, requires siz + n <= cap
+   * a throw leaves the elements built so far in the vector
+   */
+  template <bool Nothrow, typename F> void append_n(size_t n, F build) {
+    if constexpr (Nothrow) {
+      T *dst = arr + siz;
+      for_each_index<true>(n, [&](size_t i) { build(dst + i); });
+      siz += n;
+    } else {
+      for (size_t i = 0; i < n; i++, siz++) {
+        build(arr + siz);
+      }
+    }
+  }
+
+  /**
+   * @brief destroy the n elements from p
+   */
+  void destroy_n(T *p, size_t n) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+      for_each_index<true>(n, [&](size_t i) { traits::destroy(alloc, p + i); });
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        traits::destroy(alloc, p + i);
+      }
+    }
+  }
+
+  /**
+   * @brief construct n elements from p by build(q), where q points to the
+   * slot of each
+   * a throw destroys the elements built so far, leaving nothing behind
+   */
+  template <bool Nothrow, typename F>
+  void construct_n(T *p, size_t n, F build) {
+    if constexpr (Nothrow) {
+      for_each_index<true>(n, [&](size_t i) { build(p + i); });
+    } else {
+      size_t i = 0;
+      try {
+        for (; i < n; i++) {
+          build(p + i);
         }
-        alloc.deallocate(arr, cap);
+      } catch (...) {
+        destroy_n(p, i);
+        throw;
       }
-      arr = p;
-      cap = newcap;
+    }
+  }
+
+  /**
+   * @brief construct n elements in dst from src
+   * move them if the move constructor is noexcept, otherwise copy them, so
+   * that src is still intact if a constructor throws halfway
+   */
+  void relocate(T *dst, T *src, size_t n) {
+    using source = decltype(std::move_if_noexcept(*src));
+    construct_n<std::is_nothrow_constructible<T, source>::value>(
+        dst, n, [&](T *p) {
+          traits::construct(alloc, p, std::move_if_noexcept(src[p - dst]));
+        });
+  }
+
+  /**
+   * @brief destroy the elements and take p (with capacity newcap) as the new
+   * buffer
+   */
+  void adopt(T *p, size_t newcap) {
+    if (arr != nullptr) {
+      destroy_n(arr, siz);
+      traits::deallocate(alloc, arr, cap);
+    }
+    Growth::record_reallocation(newcap, sizeof(T) * siz);
+    arr = p;
+    cap = newcap;
+  }
+
+  /**
+   * @brief the capacity to grow to when the buffer is too small for n more
+   * elements
+   */
+  size_t grown(size_t n = 1) const {
+    return Growth::next_capacity(siz, siz + n, sizeof(T));
+  }
+
+  /**
+   * @brief try to grow the buffer to newcap elements without moving it, which
+   * only allocators providing expand_in_place can do
+   */
+  bool expand_in_place(size_t newcap) {
+    if constexpr (has_expand_in_place<Allocator>::value) {
+      if (arr != nullptr && alloc.expand_in_place(arr, cap, newcap)) {
+        cap = newcap;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief whether n more elements fit, growing the buffer in place if
+   * possible
+   */
+  bool fits(size_t n) { return siz + n <= cap || expand_in_place(grown(n)); }
+
+  /**
+   * @brief move the elements to a new buffer of newcap (>= siz + n) elements
+   * around a gap of n slots at ind, then update siz
+   * the gap is constructed first by fill(p), where p points to it, so fill
+   * may still read the old buffer. if fill or a copy throws, what was built
+   * in the new buffer is destroyed and the buffer is given back, leaving the
+   * vector unchanged. fill must leave nothing behind when it throws.
+   */
+  template <typename F>
+  void regrow(size_t newcap, size_t ind, size_t n, F fill) {
+    T *p = newcap ? allocate(newcap) : nullptr;
+    int done = 0; // 1 once the gap is filled, 2 once [0, ind) is moved too
+    try {
+      fill(p + ind);
+      done = 1;
+      relocate(p, arr, ind);
+      done = 2;
+      relocate(p + ind + n, arr + ind, siz - ind);
+    } catch (...) {
+      if (done == 2) {
+        destroy_n(p, ind);
+      }
+      if (done >= 1) {
+        destroy_n(p + ind, n);
+      }
+      if (p != nullptr) {
+        traits::deallocate(alloc, p, newcap);
+      }
+      throw;
+    }
+    adopt(p, newcap);
+    siz += n;
+  }
+
+  /**
+   * @brief move the elements to a new buffer of newcap (>= siz) elements
+   */
+  void reallocate(size_t newcap) {
+    regrow(newcap, siz, 0, [](T *) {});
+  }
+
+  /**
+   * @brief destroy the elements from index n on
+   */
+  void truncate(size_t n) {
+    if (siz > n) {
+      destroy_n(arr + n, siz - n);
+      siz = n;
+    }
+  }
+
+  /**
+   * @brief open a gap of n uninitialized slots at ind by shifting [ind, siz)
+   * to the right, requires siz + n <= cap
+   * trivially relocatable elements are moved as raw bytes in one memmove,
+   * others are move-assigned backwards, constructing only the slots past the
+   * end. siz is left to the caller.
+   */
+  void shift_right(size_t ind, size_t n) {
+    if (ind == siz || n == 0) {
+      return;
+    }
+    if constexpr (is_trivially_relocatable<T>::value) {
+      memmove((void *)(arr + ind + n), (void *)(arr + ind),
+              sizeof(T) * (siz - ind));
+    } else {
+      for (size_t i = siz; i-- > ind;) {
+        if (i + n >= siz) {
+          traits::construct(alloc, arr + i + n, std::move(arr[i]));
+        } else {
+          arr[i + n] = std::move(arr[i]);
+        }
+      }
+      for (size_t i = ind; i < ind + n && i < siz; i++) {
+        traits::destroy(alloc, arr + i);
+      }
+    }
+  }
+
+  /**
+   * @brief remove the n elements from ind by shifting [ind + n, siz) to the
+   * left, the same way as shift_right. siz is left to the caller.
+   */
+  void shift_left(size_t ind, size_t n) {
+    if (n == 0) {
+      return;
+    }
+    if constexpr (is_trivially_relocatable<T>::value) {
+      for (size_t i = ind; i < ind + n; i++) {
+        traits::destroy(alloc, arr + i);
+      }
+      memmove((void *)(arr + ind), (void *)(arr + ind + n),
+              sizeof(T) * (siz - ind - n));
+    } else {
+      for (size_t i = ind; i + n < siz; i++) {
+        arr[i] = std::move(arr[i + n]);
+      }
+      for (size_t i = siz - n; i < siz; i++) {
+        traits::destroy(alloc, arr + i);
+      }
+    }
+  }
+
+  /**
+   * @brief make room for n elements at ind and construct them by fill(p),
+   * where p points to the first of them, then update siz
+   * at most one reallocation and one shift of the tail are done. fill must
+   * leave nothing behind when it throws, the vector is then unchanged.
+   * if fill may throw and a shifted tail could not be shifted back by a
+   * memmove, the new elements are built at the end and rotated into place.
+   */
+  template <bool Nothrow, typename F>
+  void insert_n(size_t ind, size_t n, F fill) {
+    if (!fits(n)) {
+      regrow(grown(n), ind, n, fill);
+    } else if constexpr (Nothrow) {
+      shift_right(ind, n);
+      fill(arr + ind);
+      siz += n;
+    } else if constexpr (is_trivially_relocatable<T>::value) {
+      // the shift was a memmove, which is undone by another
+      shift_right(ind, n);
+      try {
+        fill(arr + ind);
+      } catch (...) {
+        memmove((void *)(arr + ind), (void *)(arr + ind + n),
+                sizeof(T) * (siz - ind));
+        throw;
+      }
+      siz += n;
+    } else {
+      fill(arr + siz);
+      siz += n;
+      std::rotate(arr + ind, arr + siz - n, arr + siz);
     }
   }
 
@@ -50,7 +369,7 @@ public:
    * you can see RandomAccessIterator at CppReference for help.
    */
   class const_iterator;
-  class iterator {
+  class iterator : private iterator_origin<T, Access::value> {
     // The following code is written for the C++ type_traits library.
     // Type traits is a C++ feature for describing certain properties of a type.
     // For instance, for an iterator, iterator::value_type is the type that the
@@ -64,52 +383,57 @@ public:
     // About value_type:
     // https://blog.csdn.net/u014299153/article/details/72419713 About
     // iterator_category: https://en.cppreference.com/w/cpp/iterator
+    friend class const_iterator;
+    using origin_base = iterator_origin<T, Access::value>;
+
   public:
     using difference_type = std::ptrdiff_t;
     using value_type = T;
     using pointer = T *;
     using reference = T &;
-    using iterator_category = std::output_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
   private:
     /**
      * data members
      */
-    T *beg, *ptr;
-    // beg is for judging whether two iterators point to the same vector
+    T *ptr;
+    // the origin base is for judging whether two iterators point to the same
+    // vector
 
   public:
-    iterator(T *b, T *p) : beg(b), ptr(p) {} //! How to get rid of this?
-    iterator() : beg(nullptr), ptr(nullptr) {}
+    iterator(T *b, T *p) : origin_base(b), ptr(p) {}
+    iterator() : origin_base(nullptr), ptr(nullptr) {}
     /**
      * return a new iterator which points to the nth next element
      * as well as operator-
      */
-    iterator operator+(const int &n) const {
-      // TODO
-      return iterator(beg, ptr + n);
+    iterator operator+(difference_type n) const {
+      return iterator(this->origin(), ptr + n);
     }
-    iterator operator-(const int &n) const {
-      // TODO
-      return iterator(beg, ptr - n);
+    friend iterator operator+(difference_type n, const iterator &it) {
+      return it + n;
+    }
+    iterator operator-(difference_type n) const {
+      return iterator(this->origin(), ptr - n);
     }
     // return the distance between two iterators,
     // if these two iterators point to different vectors, throw
     // invaild_iterator.
-    int operator-(const iterator &rhs) const {
-      // TODO
-      if (beg != rhs.beg) {
+    difference_type operator-(const iterator &rhs) const {
+      if (!this->same_origin(rhs)) {
         throw invalid_iterator();
       }
       return ptr - rhs.ptr;
     }
-    iterator &operator+=(const int &n) {
-      // TODO
+    iterator &operator+=(difference_type n) {
       ptr += n;
       return *this;
     }
-    iterator &operator-=(const int &n) {
-      // TODO
+    iterator &operator-=(difference_type n) {
       ptr -= n;
       return *this;
     }
@@ -141,6 +465,8 @@ public:
      * TODO *it
      */
     T &operator*() const { return *ptr; }
+    T *operator->() const { return ptr; }
+    T &operator[](difference_type n) const { return ptr[n]; }
     /**
      * an operator for checking whether two iterators are the same (pointing to
      * the same memory address).
@@ -152,57 +478,69 @@ public:
      */
     bool operator!=(const iterator &rhs) const { return ptr != rhs.ptr; }
     bool operator!=(const const_iterator &rhs) const { return ptr != rhs.ptr; }
+    bool operator<(const iterator &rhs) const { return ptr < rhs.ptr; }
+    bool operator>(const iterator &rhs) const { return ptr > rhs.ptr; }
+    bool operator<=(const iterator &rhs) const { return ptr <= rhs.ptr; }
+    bool operator>=(const iterator &rhs) const { return ptr >= rhs.ptr; }
   }; // class iterator
   /**
    * has the same function as iterator, just for a const object.
    */
-  class const_iterator {
+  class const_iterator : private iterator_origin<T, Access::value> {
+    friend class iterator;
+    using origin_base = iterator_origin<T, Access::value>;
+
   public:
     using difference_type = std::ptrdiff_t;
     using value_type = T;
-    using pointer = T *;
-    using reference = T &;
-    using iterator_category = std::output_iterator_tag;
+    using pointer = const T *;
+    using reference = const T &;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
   private:
     /**
      * data members
      */
-    T *beg, *ptr;
-    // beg is for judging whether two iterators point to the same vector
+    T *ptr;
+    // the origin base is for judging whether two iterators point to the same
+    // vector
 
   public:
-    const_iterator(T *b, T *p) : beg(b), ptr(p) {}
-    const_iterator() : beg(nullptr), ptr(nullptr) {}
+    const_iterator(T *b, T *p) : origin_base(b), ptr(p) {}
+    const_iterator() : origin_base(nullptr), ptr(nullptr) {}
+    const_iterator(const iterator &it)
+        : origin_base(it.origin()), ptr(it.ptr) {}
     /**
      * return a new iterator which pointer n-next elements
      * as well as operator-
      */
-    const_iterator operator+(const int &n) const {
-      // TODO
-      return const_iterator(beg, ptr + n);
+    const_iterator operator+(difference_type n) const {
+      return const_iterator(this->origin(), ptr + n);
     }
-    const_iterator operator-(const int &n) const {
-      // TODO
-      return const_iterator(beg, ptr - n);
+    friend const_iterator operator+(difference_type n,
+                                    const const_iterator &it) {
+      return it + n;
+    }
+    const_iterator operator-(difference_type n) const {
+      return const_iterator(this->origin(), ptr - n);
     }
     // return the distance between two iterators,
     // if these two iterators point to different vectors, throw
     // invaild_iterator.
-    int operator-(const const_iterator &rhs) const {
-      // TODO
-      if (beg != rhs.beg) {
+    difference_type operator-(const const_iterator &rhs) const {
+      if (!this->same_origin(rhs)) {
         throw invalid_iterator();
       }
       return ptr - rhs.ptr;
     }
-    const_iterator &operator+=(const int &n) {
-      // TODO
+    const_iterator &operator+=(difference_type n) {
       ptr += n;
       return *this;
     }
-    const_iterator &operator-=(const int &n) {
-      // TODO
+    const_iterator &operator-=(difference_type n) {
       ptr -= n;
       return *this;
     }
@@ -234,6 +572,8 @@ public:
      * TODO *it
      */
     const T &operator*() const { return *ptr; } //! invalid address???
+    const T *operator->() const { return ptr; }
+    const T &operator[](difference_type n) const { return ptr[n]; }
     /**
      * a operator to check whether two iterators are same (pointing to the same
      * memory address).
@@ -245,30 +585,38 @@ public:
      */
     bool operator!=(const iterator &rhs) const { return ptr != rhs.ptr; }
     bool operator!=(const const_iterator &rhs) const { return ptr != rhs.ptr; }
+    bool operator<(const const_iterator &rhs) const { return ptr < rhs.ptr; }
+    bool operator>(const const_iterator &rhs) const { return ptr > rhs.ptr; }
+    bool operator<=(const const_iterator &rhs) const { return ptr <= rhs.ptr; }
+    bool operator>=(const const_iterator &rhs) const { return ptr >= rhs.ptr; }
   }; // class const_iterator
   /**
    * TODO Constructs
    * At least two: default constructor, copy constructor
    */
   vector() : arr(nullptr), siz(0), cap(0) {}
-  vector(const vector &other) : siz(other.siz), cap(other.cap) {
-    arr = alloc.allocate(cap);
+  explicit vector(const Allocator &a)
+      : arr(nullptr), siz(0), cap(0), alloc(a) {}
+  vector(const vector &other)
+      : Growth(), siz(other.siz), cap(other.cap),
+        alloc(traits::select_on_container_copy_construction(other.alloc)) {
+    arr = cap ? allocate(cap) : nullptr;
     // copy
-    for (size_t i = 0; i < siz; i++) {
-      alloc.construct(arr + i, other.arr[i]);
+    try {
+      construct_n<std::is_nothrow_copy_constructible<T>::value>(
+          arr, siz,
+          [&](T *p) { traits::construct(alloc, p, other.arr[p - arr]); });
+    } catch (...) {
+      if (arr != nullptr) {
+        traits::deallocate(alloc, arr, cap);
+      }
+      throw;
     }
   }
   /**
    * Destructor
    */
-  ~vector() {
-    for (size_t i = 0; i < siz; i++) {
-      alloc.destroy(arr + i);
-    }
-    alloc.deallocate(arr, cap);
-    arr = nullptr;
-    siz = cap = 0;
-  }
+  ~vector() { release(); }
   /**
    * Assignment operator
    */
@@ -276,18 +624,38 @@ public:
     if (this == &other) {
       return *this;
     }
-    for (size_t i = 0; i < siz; i++) {
-      alloc.destroy(arr + i);
+    if (traits::propagate_on_container_copy_assignment::value &&
+        alloc != other.alloc) {
+      // the buffer must go back to the allocator that gave it
+      release();
+      alloc = other.alloc;
     }
-    alloc.deallocate(arr, cap);
-    siz = other.siz, cap = other.cap;
-    arr = alloc.allocate(cap);
-    // copy
-    for (size_t i = 0; i < siz; i++) {
-      alloc.construct(arr + i, other.arr[i]);
+    if (other.siz > cap) {
+      // allocate first, a throw must leave the old buffer in place
+      size_t newcap = other.siz;
+      T *p = allocate(newcap);
+      release();
+      arr = p;
+      cap = newcap;
     }
+    // reuse the live elements, construct only the surplus
+    size_t common = siz < other.siz ? siz : other.siz;
+    for_each_index<std::is_nothrow_copy_assignable<T>::value>(
+        common, [&](size_t i) { arr[i] = other.arr[i]; });
+    truncate(other.siz);
+    append_n<std::is_nothrow_copy_constructible<T>::value>(
+        other.siz - siz,
+        [&](T *p) { traits::construct(alloc, p, other.arr[p - arr]); });
     return *this;
   }
+  /**
+   * returns the growth policy, with its statistics if it keeps any
+   */
+  const Growth &growth() const { return *this; }
+  /**
+   * returns the allocator
+   */
+  Allocator get_allocator() const { return alloc; }
   /**
    * assigns specified element with bounds checking
    * throw index_out_of_bound if pos is not in [0, size)
@@ -308,16 +676,21 @@ public:
    * assigns specified element with bounds checking
    * throw index_out_of_bound if pos is not in [0, size)
    *   In STL this operator does not check the boundary but I want you to do so.
+   * an unchecked vector does not check it either.
    */
   T &operator[](const size_t &pos) {
-    if (pos >= siz) {
-      throw index_out_of_bound();
+    if constexpr (Access::value) {
+      if (pos >= siz) {
+        throw index_out_of_bound();
+      }
     }
     return arr[pos];
   }
   const T &operator[](const size_t &pos) const {
-    if (pos >= siz) {
-      throw index_out_of_bound();
+    if constexpr (Access::value) {
+      if (pos >= siz) {
+        throw index_out_of_bound();
+      }
     }
     return arr[pos];
   }
@@ -341,15 +714,22 @@ public:
     }
     return arr[siz - 1];
   }
+  /**
+   * returns the underlying array, nullptr if nothing is allocated
+   */
+  T *data() { return arr; }
+  const T *data() const { return arr; }
   /**
    * returns an iterator to the beginning.
    */
   iterator begin() { return iterator(arr, arr); }
+  const_iterator begin() const { return cbegin(); }
   const_iterator cbegin() const { return const_iterator(arr, arr); }
   /**
    * returns an iterator to the end.
    */
   iterator end() { return iterator(arr, arr + siz); }
+  const_iterator end() const { return cend(); }
   const_iterator cend() const { return const_iterator(arr, arr + siz); }
   /**
    * checks whether the container is empty
@@ -360,26 +740,77 @@ public:
    */
   size_t size() const { return siz; }
   /**
-   * clears the contents
+   * returns the number of elements that can be held without reallocation
    */
-  void clear() {
-    for (size_t i = 0; i < siz; i++) {
-      alloc.destroy(arr + i);
+  size_t capacity() const { return cap; }
+  /**
+   * makes the capacity at least n, so that the next n - size() insertions
+   * do not reallocate
+   */
+  void reserve(const size_t &n) {
+    if (n > cap && !expand_in_place(n)) {
+      reallocate(n);
+    }
+  }
+  /**
+   * resizes to n elements, the extra ones are value-initialized (or copies of
+   * value)
+   */
+  void resize(const size_t &n) {
+    if (n <= siz) {
+      truncate(n);
+      return;
+    }
+    reserve(n);
+    append_n<std::is_nothrow_default_constructible<T>::value>(
+        n - siz, [&](T *p) { traits::construct(alloc, p); });
+  }
+  void resize(const size_t &n, const T &value) {
+    if (n <= siz) {
+      truncate(n);
+      return;
+    }
+    if (n > cap && !expand_in_place(n)) {
+      // fill the new buffer first, value may refer into the old one
+      regrow(n, siz, n - siz, [&](T *p) {
+        construct_n<std::is_nothrow_copy_constructible<T>::value>(
+            p, n - siz, [&](T *q) { traits::construct(alloc, q, value); });
+      });
+      return;
+    }
+    append_n<std::is_nothrow_copy_constructible<T>::value>(
+        n - siz, [&](T *p) { traits::construct(alloc, p, value); });
+  }
+  /**
+   * releases the unused capacity
+   */
+  void shrink_to_fit() {
+    if (siz < cap) {
+      reallocate(siz);
+    }
+  }
+  /**
+   * clears the contents, the capacity is kept for later insertions
+   */
+  void clear() { truncate(0); }
+  /**
+   * clears the contents and frees the storage
+   */
+  void release() {
+    clear();
+    if (arr != nullptr) {
+      traits::deallocate(alloc, arr, cap);
     }
-    alloc.deallocate(arr, cap);
     arr = nullptr;
-    siz = cap = 0;
+    cap = 0;
   }
   /**
    * inserts value before pos
    * returns an iterator pointing to the inserted value.
    */
-  iterator insert(iterator pos, const T &value) {
-    int ind = pos - begin();
-    if (ind < 0 || ind > siz) {
-      throw invalid_iterator(); //? what error?
-    };
-    return insert(ind, value);
+  iterator insert(iterator pos, const T &value) { return emplace(pos, value); }
+  iterator insert(iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
   }
   /**
    * inserts value at index ind.
@@ -389,14 +820,121 @@ public:
    * because after inserting the size will increase 1.)
    */
   iterator insert(const size_t &ind, const T &value) {
+    return emplace(ind, value);
+  }
+  iterator insert(const size_t &ind, T &&value) {
+    return emplace(ind, std::move(value));
+  }
+  /**
+   * inserts n copies of value before pos
+   * returns an iterator pointing to the first inserted value.
+   */
+  iterator insert(iterator pos, const size_t &n, const T &value) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) > siz) {
+      throw invalid_iterator();
+    };
+    return insert(ind, n, value);
+  }
+  /**
+   * inserts n copies of value at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  iterator insert(const size_t &ind, const size_t &n, const T &value) {
+    if (ind > siz) {
+      throw index_out_of_bound();
+    }
+    T tmp(value); // value may refer to an element that is about to be shifted
+    constexpr bool nothrow = std::is_nothrow_copy_constructible<T>::value;
+    insert_n<nothrow>(ind, n, [&](T *p) {
+      construct_n<nothrow>(
+          p, n, [&](T *q) { traits::construct(alloc, q, tmp); });
+    });
+    return begin() + ind;
+  }
+  /**
+   * inserts the elements of [first, last) before pos
+   * first and last must not point into this vector.
+   * returns an iterator pointing to the first inserted value.
+   */
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  iterator insert(iterator pos, InputIt first, InputIt last) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) > siz) {
+      throw invalid_iterator();
+    };
+    return insert(ind, first, last);
+  }
+  /**
+   * inserts the elements of [first, last) at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  iterator insert(const size_t &ind, InputIt first, InputIt last) {
+    if (ind > siz) {
+      throw index_out_of_bound();
+    }
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+      // count first, so that the tail is shifted once
+      size_t n = std::distance(first, last);
+      insert_n<false>(ind, n, [&](T *p) {
+        InputIt it = first;
+        construct_n<false>(
+            p, n, [&](T *q) { traits::construct(alloc, q, *it++); });
+      });
+    } else {
+      // a single pass input can only be read once: append the elements, then
+      // rotate them into place
+      size_t old = siz;
+      try {
+        for (; first != last; ++first) {
+          emplace_back(*first);
+        }
+      } catch (...) {
+        truncate(old);
+        throw;
+      }
+      std::rotate(arr + ind, arr + old, arr + siz);
+    }
+    return begin() + ind;
+  }
+  /**
+   * constructs an element from args before pos
+   * returns an iterator pointing to the new element.
+   */
+  template <typename... Args> iterator emplace(iterator pos, Args &&...args) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) > siz) {
+      throw invalid_iterator(); //? what error?
+    };
+    return emplace(ind, std::forward<Args>(args)...);
+  }
+  /**
+   * constructs an element from args at index ind.
+   * throw index_out_of_bound if ind > size
+   */
+  template <typename... Args>
+  iterator emplace(const size_t &ind, Args &&...args) {
     if (ind > siz) {
       throw index_out_of_bound();
     }
-    expand();
-    for (size_t i = siz++; i > ind; i--) {
-      alloc.construct(arr + i, arr[i - 1]); // use copy constructor
+    if (ind == siz) {
+      emplace_back(std::forward<Args>(args)...);
+    } else if (fits(1)) {
+      // args may refer to an element that is about to be shifted
+      T tmp(std::forward<Args>(args)...);
+      shift_right(ind, 1);
+      traits::construct(alloc, arr + ind, std::move(tmp));
+      siz++;
+    } else {
+      // build the new element first, while args are still valid
+      regrow(grown(), ind, 1, [&](T *p) {
+        traits::construct(alloc, p, std::forward<Args>(args)...);
+      });
     }
-    alloc.construct(arr + ind, value);
     return begin() + ind;
   }
   /**
@@ -406,8 +944,8 @@ public:
    * returned.
    */
   iterator erase(iterator pos) {
-    int ind = pos - begin();
-    if (ind < 0 || ind >= siz) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) >= siz) {
       throw invalid_iterator(); //!? what error?
     };
     return erase(ind);
@@ -418,23 +956,93 @@ public:
    * throw index_out_of_bound if ind >= size
    */
   iterator erase(const size_t &ind) {
-    if (ind > siz) {
+    if (ind >= siz) {
       throw index_out_of_bound();
     }
+    shift_left(ind, 1);
     siz--;
-    for (size_t i = ind; i < siz; i++) {
-      arr[i] = arr[i + 1];
-    }
-    alloc.destroy(arr + siz);
     return begin() + ind;
   }
+  /**
+   * removes the elements in [first, last).
+   * return an iterator pointing to the element following the removed ones.
+   */
+  iterator erase(iterator first, iterator last) {
+    std::ptrdiff_t l = first - begin(), r = last - begin();
+    if (l < 0 || l > r || size_t(r) > siz) {
+      throw invalid_iterator();
+    }
+    shift_left(l, r - l);
+    siz -= r - l;
+    return begin() + l;
+  }
+  /**
+   * removes the element with index ind in O(1) by moving the last element
+   * into its place, so the order of the elements is not kept.
+   * throw index_out_of_bound if ind >= size
+   */
+  void swap_remove(const size_t &ind) {
+    if (ind >= siz) {
+      throw index_out_of_bound();
+    }
+    siz--;
+    if (ind == siz) {
+      traits::destroy(alloc, arr + siz);
+    } else if constexpr (is_trivially_relocatable<T>::value) {
+      traits::destroy(alloc, arr + ind);
+      memcpy((void *)(arr + ind), (void *)(arr + siz), sizeof(T));
+    } else {
+      arr[ind] = std::move(arr[siz]);
+      traits::destroy(alloc, arr + siz);
+    }
+  }
+  void swap_remove(iterator pos) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) >= siz) {
+      throw invalid_iterator();
+    }
+    swap_remove(size_t(ind));
+  }
+  /**
+   * removes every element for which pred returns true, in one pass that
+   * moves each kept element straight to its final place. the kept elements
+   * stay in order.
+   * return the number of removed elements.
+   */
+  template <typename Pred> size_t erase_if(Pred pred) {
+    size_t kept = 0;
+    for (size_t i = 0; i < siz; i++) {
+      if (!pred(arr[i])) {
+        if (i != kept) {
+          arr[kept] = std::move(arr[i]);
+        }
+        kept++;
+      }
+    }
+    size_t removed = siz - kept;
+    truncate(kept);
+    return removed;
+  }
   /**
    * adds an element to the end.
    */
-  void push_back(const T &value) {
-    expand();
-    alloc.construct(arr + siz++, value);
-    // must call copy constructor, otherwise the object may be uninitialized
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  /**
+   * constructs an element from args at the end.
+   * returns a reference to the new element.
+   */
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (fits(1)) {
+      traits::construct(alloc, arr + siz, std::forward<Args>(args)...);
+      siz++;
+    } else {
+      // build the new element first, args may refer into the old buffer
+      regrow(grown(), siz, 1, [&](T *p) {
+        traits::construct(alloc, p, std::forward<Args>(args)...);
+      });
+    }
+    return arr[siz - 1];
   }
   /**
    * remove the last element from the end.
@@ -444,10 +1052,116 @@ public:
     if (!siz) {
       throw container_is_empty();
     }
-    alloc.destroy(arr + (--siz));
+    traits::destroy(alloc, arr + (--siz));
+  }
+  /**
+   * writes the elements to os after a header of an endianness tag, the
+   * element size and the count.
+   * trivially copyable elements are written in one block, others one by one
+   * through serializer<T>::save (the element size is then recorded as 0).
+   * throw runtime_error if writing fails
+   */
+  void save(std::ostream &os) const {
+    uint32_t head[2] = {ENDIAN_TAG, bulk() ? uint32_t(sizeof(T)) : 0};
+    uint64_t count = siz;
+    os.write(reinterpret_cast<const char *>(head), sizeof(head));
+    os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    if constexpr (bulk()) {
+      os.write(reinterpret_cast<const char *>(arr), sizeof(T) * siz);
+    } else {
+      for (size_t i = 0; i < siz; i++) {
+        serializer<T>::save(os, arr[i]);
+      }
+    }
+    if (!os) {
+      throw runtime_error();
+    }
+  }
+  /**
+   * replaces the elements with those written by save.
+   * the count in the stream is not trusted: no more is allocated up front
+   * than the rest of the stream can hold (or LOAD_CHUNK bytes if the stream
+   * cannot tell), so a stream that can tell how much is left is read with a
+   * single allocation.
+   * throw runtime_error if the data was written on a machine of another
+   * endianness or for another element type, which leaves the vector as it
+   * was, or if reading fails or the stream is too short for the count, which
+   * leaves it empty.
+   */
+  void load(std::istream &is) {
+    uint32_t head[2];
+    uint64_t count;
+    is.read(reinterpret_cast<char *>(head), sizeof(head));
+    is.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!is || head[0] != ENDIAN_TAG ||
+        head[1] != (bulk() ? uint32_t(sizeof(T)) : 0)) {
+      throw runtime_error();
+    }
+    clear();
+    size_t left = remaining(is);
+    if (bulk() && left != SIZE_MAX && count > left / sizeof(T)) {
+      throw runtime_error();
+    }
+    // a serialized element is taken to need at least a byte of the stream
+    size_t room = left != SIZE_MAX ? left / (bulk() ? sizeof(T) : 1)
+                                   : LOAD_CHUNK / sizeof(T);
+    reserve(count < room ? count : room);
+    try {
+      if constexpr (bulk()) {
+        while (siz < count) {
+          if (siz == cap) {
+            // the stream could not tell its length, read it in doubling chunks
+            size_t more = cap ? cap : 1;
+            reserve(count - siz < more ? count : siz + more);
+          }
+          size_t n = (count < cap ? count : cap) - siz;
+          is.read(reinterpret_cast<char *>(arr + siz), sizeof(T) * n);
+          if (!is) {
+            throw runtime_error();
+          }
+          siz += n;
+        }
+      } else {
+        while (siz < count) {
+          // check the stream before the element goes into the vector
+          T x = serializer<T>::load(is);
+          if (!is) {
+            throw runtime_error();
+          }
+          emplace_back(std::move(x));
+        }
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+private:
+  // reads back as 0x01020304 only on a machine of the same endianness
+  static constexpr uint32_t ENDIAN_TAG = 0x01020304;
+  // what load allocates at first when the stream cannot tell its length
+  static constexpr size_t LOAD_CHUNK = size_t(1) << 20;
+
+  static constexpr bool bulk() { return std::is_trivially_copyable<T>::value; }
+
+  /**
+   * @brief the number of bytes left in is, SIZE_MAX if it cannot tell
+   */
+  static size_t remaining(std::istream &is) {
+    std::streampos here = is.tellg();
+    if (here == std::streampos(-1) || !is.seekg(0, std::ios::end)) {
+      is.clear();
+      return SIZE_MAX;
+    }
+    std::streampos end = is.tellg();
+    is.seekg(here);
+    return end > here ? size_t(end - here) : 0;
   }
 }; // class vector
 
 } // namespace sjtu
 
+#include "vector_bool.hpp"
+
 #endif
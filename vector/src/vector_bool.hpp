@@ -0,0 +1,559 @@
+#ifndef SJTU_VECTOR_BOOL_HPP
+#define SJTU_VECTOR_BOOL_HPP
+
+#include "vector.hpp"
+
+namespace sjtu {
+/**
+ * vector<bool> packs the flags into 64-bit words: flag i is bit i % 64 of
+ * word i / 64, and the bits of the last word past size() are kept zero.
+ * a flag has no address of its own, so operator[] and the iterators hand out
+ * a reference proxy instead of a bool &.
+ * growing copies whole words, and count, find_first, find_next, flip and the
+ * bitwise operators go a word at a time.
+ * Growth is asked for capacities in words.
+ */
+template <typename Allocator, typename Access, typename Growth>
+class vector<bool, Allocator, Access, Growth> : private Growth {
+private:
+  using word = uint64_t;
+  using word_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<word>;
+  using traits = std::allocator_traits<word_allocator>;
+  static const size_t BITS = 64;
+
+  word *arr;            // words
+  size_t siz;           // size in flags
+  size_t cap;           // capacity in words
+  word_allocator alloc; // allocator
+
+  static size_t words(size_t n) { return (n + BITS - 1) / BITS; }
+  static word bit(size_t pos) { return word(1) << (pos % BITS); }
+  /**
+   * @brief the mask of the bits below bit b of a word, b < 64
+   */
+  static word low(size_t b) { return (word(1) << b) - 1; }
+
+  static size_t popcount(word w) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(w);
+#else
+    size_t r = 0;
+    for (; w; w &= w - 1) {
+      r++;
+    }
+    return r;
+#endif
+  }
+  /**
+   * @brief the index of the lowest set bit of w != 0
+   */
+  static size_t ctz(word w) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(w);
+#else
+    size_t r = 0;
+    for (; !(w & 1); w >>= 1) {
+      r++;
+    }
+    return r;
+#endif
+  }
+
+  /**
+   * @brief move the words to a new buffer of newcap (>= words(siz)) words
+   */
+  void reallocate(size_t newcap) {
+    word *p = newcap ? traits::allocate(alloc, newcap) : nullptr;
+    if (siz) {
+      memcpy(p, arr, sizeof(word) * words(siz));
+    }
+    if (arr != nullptr) {
+      traits::deallocate(alloc, arr, cap);
+    }
+    Growth::record_reallocation(newcap, sizeof(word) * words(siz));
+    arr = p;
+    cap = newcap;
+  }
+
+  /**
+   * @brief make room for one more flag, growing as Growth says
+   */
+  void grow() {
+    if (siz == cap * BITS) {
+      reallocate(Growth::next_capacity(cap, cap + 1, sizeof(word)));
+    }
+    if (siz % BITS == 0) {
+      arr[siz / BITS] = 0;
+    }
+  }
+
+  /**
+   * @brief clear the bits of the last word from flag siz on
+   */
+  void clear_tail() {
+    if (siz % BITS) {
+      arr[siz / BITS] &= low(siz % BITS);
+    }
+  }
+
+  template <bool Const> class basic_iterator;
+
+public:
+  /**
+   * stands for one flag, converts to bool and assigns through to the word
+   */
+  class reference {
+    friend class vector;
+    template <bool Const> friend class basic_iterator;
+
+  private:
+    word *w;
+    word mask;
+
+    reference(word *p, word m) : w(p), mask(m) {}
+
+  public:
+    operator bool() const { return (*w & mask) != 0; }
+    bool operator~() const { return !bool(*this); }
+    reference &operator=(bool x) {
+      if (x) {
+        *w |= mask;
+      } else {
+        *w &= ~mask;
+      }
+      return *this;
+    }
+    reference &operator=(const reference &x) { return *this = bool(x); }
+    void flip() { *w ^= mask; }
+  };
+  using const_reference = bool;
+
+private:
+  /**
+   * an iterator is the word array and a flag index. a checked vector
+   * compares the arrays to tell iterators of different vectors apart.
+   */
+  template <bool Const> class basic_iterator {
+    friend class vector;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = bool;
+    using pointer = void;
+    using reference = std::conditional_t<Const, bool, vector::reference>;
+    using iterator_category = std::random_access_iterator_tag;
+
+  private:
+    word *p;
+    size_t pos;
+
+    basic_iterator(word *w, size_t i) : p(w), pos(i) {}
+
+  public:
+    basic_iterator() : p(nullptr), pos(0) {}
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &it) : p(it.p), pos(it.pos) {}
+
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(p, pos + n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(p, pos - n);
+    }
+    // return the distance between two iterators,
+    // if these two iterators point to different vectors, throw
+    // invaild_iterator.
+    difference_type operator-(const basic_iterator &rhs) const {
+      if (Access::value && p != rhs.p) {
+        throw invalid_iterator();
+      }
+      return difference_type(pos - rhs.pos);
+    }
+    basic_iterator &operator+=(difference_type n) {
+      pos += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      pos -= n;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      pos++;
+      return tmp;
+    }
+    basic_iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      pos--;
+      return tmp;
+    }
+    basic_iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    reference operator*() const {
+      return vector::reference(p + pos / BITS, bit(pos));
+    }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    bool operator==(const basic_iterator &rhs) const {
+      return p == rhs.p && pos == rhs.pos;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return pos < rhs.pos; }
+    bool operator>(const basic_iterator &rhs) const { return pos > rhs.pos; }
+    bool operator<=(const basic_iterator &rhs) const { return pos <= rhs.pos; }
+    bool operator>=(const basic_iterator &rhs) const { return pos >= rhs.pos; }
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  vector() : arr(nullptr), siz(0), cap(0) {}
+  explicit vector(const Allocator &a)
+      : arr(nullptr), siz(0), cap(0), alloc(a) {}
+  vector(const vector &other)
+      : Growth(), arr(nullptr), siz(0), cap(0),
+        alloc(traits::select_on_container_copy_construction(other.alloc)) {
+    if (other.siz) {
+      size_t newcap = words(other.siz);
+      arr = traits::allocate(alloc, newcap);
+      cap = newcap;
+      memcpy(arr, other.arr, sizeof(word) * cap);
+      siz = other.siz;
+    }
+  }
+  /**
+   * Destructor
+   */
+  ~vector() { release(); }
+  /**
+   * Assignment operator
+   */
+  vector &operator=(const vector &other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (traits::propagate_on_container_copy_assignment::value &&
+        alloc != other.alloc) {
+      // the buffer must go back to the allocator that gave it
+      release();
+      alloc = other.alloc;
+    }
+    if (words(other.siz) > cap) {
+      // allocate first, a throw must leave the old buffer in place
+      size_t newcap = words(other.siz);
+      word *p = traits::allocate(alloc, newcap);
+      release();
+      arr = p;
+      cap = newcap;
+    }
+    if (other.siz) {
+      memcpy(arr, other.arr, sizeof(word) * words(other.siz));
+    }
+    siz = other.siz;
+    return *this;
+  }
+  /**
+   * returns the growth policy, with its statistics if it keeps any
+   */
+  const Growth &growth() const { return *this; }
+  /**
+   * returns the allocator
+   */
+  Allocator get_allocator() const { return Allocator(alloc); }
+  /**
+   * assigns specified element with bounds checking
+   * throw index_out_of_bound if pos is not in [0, size)
+   */
+  reference at(const size_t &pos) {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return reference(arr + pos / BITS, bit(pos));
+  }
+  bool at(const size_t &pos) const {
+    if (pos >= siz) {
+      throw index_out_of_bound();
+    }
+    return (arr[pos / BITS] & bit(pos)) != 0;
+  }
+  /**
+   * as at(), but an unchecked vector does not check the bounds
+   */
+  reference operator[](const size_t &pos) {
+    if constexpr (Access::value) {
+      return at(pos);
+    } else {
+      return reference(arr + pos / BITS, bit(pos));
+    }
+  }
+  bool operator[](const size_t &pos) const {
+    if constexpr (Access::value) {
+      return at(pos);
+    } else {
+      return (arr[pos / BITS] & bit(pos)) != 0;
+    }
+  }
+  /**
+   * access the first element.
+   * throw container_is_empty if size == 0
+   */
+  bool front() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return at(0);
+  }
+  /**
+   * access the last element.
+   * throw container_is_empty if size == 0
+   */
+  bool back() const {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    return at(siz - 1);
+  }
+  iterator begin() { return iterator(arr, 0); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(arr, 0); }
+  iterator end() { return iterator(arr, siz); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(arr, siz); }
+  bool empty() const { return !siz; }
+  size_t size() const { return siz; }
+  /**
+   * returns the number of flags that can be held without reallocation
+   */
+  size_t capacity() const { return cap * BITS; }
+  /**
+   * makes the capacity at least n flags
+   */
+  void reserve(const size_t &n) {
+    if (words(n) > cap) {
+      reallocate(words(n));
+    }
+  }
+  /**
+   * resizes to n flags, the new ones are set to value
+   */
+  void resize(const size_t &n, bool value = false) {
+    if (n <= siz) {
+      siz = n;
+      clear_tail();
+      return;
+    }
+    reserve(n);
+    for (size_t i = words(siz); i < words(n); i++) {
+      arr[i] = 0;
+    }
+    if (value) {
+      size_t i = siz;
+      for (; i < n && i % BITS; i++) {
+        arr[i / BITS] |= bit(i);
+      }
+      for (; i + BITS <= n; i += BITS) {
+        arr[i / BITS] = ~word(0);
+      }
+      if (i < n) {
+        arr[i / BITS] = low(n - i);
+      }
+    }
+    siz = n;
+  }
+  /**
+   * releases the unused capacity
+   */
+  void shrink_to_fit() {
+    if (words(siz) < cap) {
+      reallocate(words(siz));
+    }
+  }
+  /**
+   * clears the contents, the capacity is kept for later insertions
+   */
+  void clear() { siz = 0; }
+  /**
+   * clears the contents and frees the storage
+   */
+  void release() {
+    if (arr != nullptr) {
+      traits::deallocate(alloc, arr, cap);
+    }
+    arr = nullptr;
+    siz = 0;
+    cap = 0;
+  }
+  /**
+   * inserts value at index ind, the flags from ind on move up a word at a
+   * time.
+   * throw index_out_of_bound if ind > size
+   */
+  iterator insert(const size_t &ind, bool value) {
+    if (ind > siz) {
+      throw index_out_of_bound();
+    }
+    grow();
+    size_t k = ind / BITS;
+    for (size_t i = siz / BITS; i > k; i--) {
+      arr[i] = arr[i] << 1 | arr[i - 1] >> (BITS - 1);
+    }
+    word below = arr[k] & low(ind % BITS);
+    arr[k] = (arr[k] & ~below) << 1 | below;
+    if (value) {
+      arr[k] |= bit(ind);
+    }
+    siz++;
+    return begin() + ind;
+  }
+  /**
+   * inserts value before pos
+   */
+  iterator insert(iterator pos, bool value) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) > siz) {
+      throw invalid_iterator();
+    }
+    return insert(ind, value);
+  }
+  /**
+   * removes the flag with index ind, the flags after it move down a word at
+   * a time.
+   * throw index_out_of_bound if ind >= size
+   */
+  iterator erase(const size_t &ind) {
+    if (ind >= siz) {
+      throw index_out_of_bound();
+    }
+    size_t k = ind / BITS, last = (siz - 1) / BITS;
+    word below = arr[k] & low(ind % BITS);
+    arr[k] = (arr[k] >> 1 & ~low(ind % BITS)) | below;
+    for (size_t i = k; i < last; i++) {
+      arr[i] |= (arr[i + 1] & 1) << (BITS - 1);
+      arr[i + 1] >>= 1;
+    }
+    siz--;
+    return begin() + ind;
+  }
+  /**
+   * removes the flag at pos
+   */
+  iterator erase(iterator pos) {
+    std::ptrdiff_t ind = pos - begin();
+    if (ind < 0 || size_t(ind) >= siz) {
+      throw invalid_iterator();
+    }
+    return erase(ind);
+  }
+  /**
+   * adds a flag to the end.
+   */
+  void push_back(bool value) {
+    grow();
+    if (value) {
+      arr[siz / BITS] |= bit(siz);
+    }
+    siz++;
+  }
+  /**
+   * remove the last flag from the end.
+   * throw container_is_empty if size() == 0
+   */
+  void pop_back() {
+    if (!siz) {
+      throw container_is_empty();
+    }
+    siz--;
+    clear_tail();
+  }
+  /**
+   * returns the number of flags that are set
+   */
+  size_t count() const {
+    size_t r = 0;
+    for (size_t i = 0; i < words(siz); i++) {
+      r += popcount(arr[i]);
+    }
+    return r;
+  }
+  /**
+   * returns the index of the first flag that is set, or size() if none is
+   */
+  size_t find_first() const { return siz ? scan(0) : 0; }
+  /**
+   * returns the index of the first flag after pos that is set, or size() if
+   * none is
+   */
+  size_t find_next(const size_t &pos) const {
+    return pos + 1 >= siz ? siz : scan(pos + 1);
+  }
+  /**
+   * inverts every flag
+   */
+  void flip() {
+    for (size_t i = 0; i < words(siz); i++) {
+      arr[i] = ~arr[i];
+    }
+    clear_tail();
+  }
+  /**
+   * the bitwise operators combine the flags of two vectors of the same size
+   * a word at a time.
+   * throw runtime_error if the sizes differ
+   */
+  template <typename A, typename C, typename G>
+  vector &operator&=(const vector<bool, A, C, G> &other) {
+    return combine(other, [](word a, word b) { return a & b; });
+  }
+  template <typename A, typename C, typename G>
+  vector &operator|=(const vector<bool, A, C, G> &other) {
+    return combine(other, [](word a, word b) { return a | b; });
+  }
+  template <typename A, typename C, typename G>
+  vector &operator^=(const vector<bool, A, C, G> &other) {
+    return combine(other, [](word a, word b) { return a ^ b; });
+  }
+
+private:
+  template <typename U, typename A, typename C, typename G>
+  friend class vector;
+
+  /**
+   * @brief the first set flag from pos < size() on, or size()
+   */
+  size_t scan(size_t pos) const {
+    size_t k = pos / BITS;
+    word w = arr[k] & ~low(pos % BITS);
+    while (!w) {
+      if (++k == words(siz)) {
+        return siz;
+      }
+      w = arr[k];
+    }
+    return k * BITS + ctz(w);
+  }
+
+  template <typename V, typename F> vector &combine(const V &other, F op) {
+    if (siz != other.siz) {
+      throw runtime_error();
+    }
+    for (size_t i = 0; i < words(siz); i++) {
+      arr[i] = op(arr[i], other.arr[i]);
+    }
+    return *this;
+  }
+};
+
+} // namespace sjtu
+
+#endif
@@ -2,40 +2,139 @@
 #define SJTU_VECTOR_HPP
 
 #include "exceptions.hpp"
+#include "growth.hpp"
+#include "type_traits.hpp"
 
 #include <climits>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 namespace sjtu {
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * Growth decides the capacity to grow to, see growth.hpp.
  */
-template <typename T> class vector {
+template <typename T, typename Growth = geometric_growth<2, 1, 2>>
+class vector : private Growth {
   T *arr;     // array
   size_t siz; // size
   size_t cap; // capacity
 
+  /**
+   * buffers of trivially relocatable elements with at least this many bytes
+   * are mapped directly, so that growing them remaps pages instead of copying
+   */
+  static const size_t MAP_THRESHOLD = 1 << 20;
+
+  /**
+   * @brief whether a buffer of n elements is obtained by mmap
+   */
+  static bool mapped(size_t n) {
+#ifdef __linux__
+    return is_trivially_relocatable<T>::value && n * sizeof(T) >= MAP_THRESHOLD;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief get raw memory for n elements
+   */
+  static T *allocate(size_t n) {
+#ifdef __linux__
+    if (mapped(n)) {
+      void *p = mmap(nullptr, sizeof(T) * n, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      return (T *)p;
+    }
+#endif
+    T *p = (T *)malloc(sizeof(T) * n);
+    if (p == nullptr && n != 0) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  /**
+   * @brief give back the memory got by allocate(n)
+   */
+  static void deallocate(T *p, size_t n) {
+#ifdef __linux__
+    if (mapped(n)) {
+      munmap(p, sizeof(T) * n);
+      return;
+    }
+#endif
+    free(p);
+  }
+
+  /**
+   * @brief resize the buffer of trivially relocatable elements from oldn to
+   * newn, keeping the first siz elements
+   * realloc or mremap may extend it in place, or move the pages without
+   * touching the data
+   * throw std::bad_alloc if there is no memory, p is then left intact
+   */
+  static T *reallocate(T *p, size_t siz, size_t oldn, size_t newn) {
+#ifdef __linux__
+    if (mapped(newn)) {
+      if (!mapped(oldn)) {
+        T *q = allocate(newn);
+        memcpy((void *)q, (void *)p, sizeof(T) * siz);
+        free(p);
+        return q;
+      }
+      void *q = mremap(p, sizeof(T) * oldn, sizeof(T) * newn, MREMAP_MAYMOVE);
+      if (q == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      return (T *)q;
+    }
+#endif
+    T *q = (T *)realloc((void *)p, sizeof(T) * newn);
+    if (q == nullptr) {
+      throw std::bad_alloc();
+    }
+    return q;
+  }
+
   /**
    * @brief expand to fit more elements
    */
   void expand() {
     if (siz >= cap) {
-      cap = siz * 2 + 2;
-      T *p = (T *)malloc(sizeof(T) * cap);
+      size_t newcap = Growth::next_capacity(siz, siz + 1, sizeof(T));
+      if (is_trivially_relocatable<T>::value) {
+        arr = reallocate(arr, siz, cap, newcap);
+        Growth::record_reallocation(newcap, sizeof(T) * siz);
+        cap = newcap;
+        return;
+      }
+      T *p = allocate(newcap);
+      Growth::record_reallocation(newcap, sizeof(T) * siz);
       // copy
       for (int i = 0; i < siz; i++) {
         new (p + i) T(arr[i]);
       }
-      // std::cerr << sizeof(T) << ' ' << siz << ' ' << cap << std::endl;
       if (arr != nullptr) {
         for (int i = 0; i < siz; i++) {
           arr[i].~T();
         }
-        free(arr);
+        deallocate(arr, cap);
       }
       arr = p;
+      cap = newcap;
     }
   }
 
@@ -254,7 +353,7 @@ public:
    */
   vector() : arr(nullptr), siz(0), cap(0) {}
   vector(const vector &other) : siz(other.siz), cap(other.cap) {
-    arr = (T *)malloc(sizeof(T) * cap);
+    arr = allocate(cap);
     // copy
     for (int i = 0; i < siz; i++) {
       new (arr + i) T(other.arr[i]);
@@ -267,7 +366,7 @@ public:
     for (int i = 0; i < siz; i++) {
       arr[i].~T();
     }
-    free(arr);
+    deallocate(arr, cap);
     arr = nullptr;
     siz = cap = 0;
   }
@@ -281,9 +380,9 @@ public:
     for (int i = 0; i < siz; i++) {
       arr[i].~T();
     }
-    free(arr);
+    deallocate(arr, cap);
     siz = other.siz, cap = other.cap;
-    arr = (T *)malloc(sizeof(T) * cap);
+    arr = allocate(cap);
     // copy
     for (int i = 0; i < siz; i++) {
       new (arr + i) T(other.arr[i]);
@@ -362,6 +461,10 @@ public:
    * returns the number of elements
    */
   size_t size() const { return siz; }
+  /**
+   * returns the growth policy, with its statistics if it keeps any
+   */
+  const Growth &growth() const { return *this; }
   /**
    * clears the contents
    */
@@ -369,7 +472,7 @@ public:
     for (int i = 0; i < siz; i++) {
       arr[i].~T();
     }
-    free(arr);
+    deallocate(arr, cap);
     arr = nullptr;
     siz = cap = 0;
   }